@@ -1,8 +1,332 @@
 #include "FunctionSelectors.h"
 
+#include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAttributeModifier/SimpleAttributeModifier.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Selector Functions Resolved"), STAT_SimpleGAS_SelectorFunctionsResolved, STATGROUP_SimpleGAS);
+
+namespace FunctionSelectors
+{
+	enum class EParameterType : uint8
+	{
+		GameplayTag,
+		Float,
+		InstancedStruct,
+		AbilityComponent,
+	};
+
+	// The parameters of each prototype, in order
+	static const EParameterType GetCustomFloatInputValueParameters[] = { EParameterType::GameplayTag, EParameterType::Float };
+	static const EParameterType ApplyFloatAttributeOperationParameters[] = {
+		EParameterType::GameplayTag, EParameterType::Float, EParameterType::Float, EParameterType::Float,
+		EParameterType::GameplayTag, EParameterType::Float, EParameterType::Float };
+	static const EParameterType ModifyStructAttributeValueParameters[] = { EParameterType::GameplayTag, EParameterType::InstancedStruct, EParameterType::InstancedStruct };
+	static const EParameterType GetStructContextParameters[] = { EParameterType::InstancedStruct };
+	static const EParameterType GetAttributeModifierSideEffectTargetsParameters[] = { EParameterType::AbilityComponent, EParameterType::AbilityComponent };
+
+	struct FNativeFunctions
+	{
+		UFunctionSelectors::FNativeGetCustomFloatInputValue GetCustomFloatInputValue = nullptr;
+		UFunctionSelectors::FNativeApplyFloatAttributeOperation ApplyFloatAttributeOperation = nullptr;
+		UFunctionSelectors::FNativeModifyStructAttributeValue ModifyStructAttributeValue = nullptr;
+		UFunctionSelectors::FNativeGetStructContext GetStructContext = nullptr;
+		UFunctionSelectors::FNativeGetAttributeModifierSideEffectTargets GetAttributeModifierSideEffectTargets = nullptr;
+	};
+
+	struct FResolvedFunction
+	{
+		TWeakObjectPtr<UFunction> Function;
+		// The function's parameters matching the prototype, in prototype order. Empty if the function doesn't match.
+		TArray<FProperty*, TInlineAllocator<8>> Parameters;
+		FNativeFunctions NativeFunctions;
+	};
+
+	// A function selector as seen from a modifier class. Self context selectors resolve differently in every class.
+	struct FResolvedFunctionKey
+	{
+		TObjectKey<UClass> ModifierClass;
+		TObjectKey<UClass> MemberParentClass;
+		FName MemberName;
+
+		bool operator==(const FResolvedFunctionKey& Other) const
+		{
+			return ModifierClass == Other.ModifierClass && MemberParentClass == Other.MemberParentClass && MemberName == Other.MemberName;
+		}
+
+		friend uint32 GetTypeHash(const FResolvedFunctionKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.ModifierClass), GetTypeHash(Key.MemberParentClass)), GetTypeHash(Key.MemberName));
+		}
+	};
+
+	static TMap<FResolvedFunctionKey, FResolvedFunction> ResolvedFunctions;
+	static TMap<TPair<TObjectKey<UClass>, FName>, FNativeFunctions> NativeFunctionRegistry;
+
+	static bool IsParameterOfType(const FProperty* Property, const EParameterType ParameterType)
+	{
+		switch (ParameterType)
+		{
+			case EParameterType::GameplayTag:
+			{
+				const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+				return StructProperty && StructProperty->Struct == FGameplayTag::StaticStruct();
+			}
+
+			case EParameterType::Float:
+				// Blueprint floats are doubles
+				return Property->IsA<FFloatProperty>() || Property->IsA<FDoubleProperty>();
+
+			case EParameterType::InstancedStruct:
+			{
+				const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+				return StructProperty && StructProperty->Struct == FInstancedStruct::StaticStruct();
+			}
+
+			case EParameterType::AbilityComponent:
+			{
+				const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property);
+				return ObjectProperty && ObjectProperty->PropertyClass && ObjectProperty->PropertyClass->IsChildOf(USimpleGameplayAbilityComponent::StaticClass());
+			}
+		}
+
+		return false;
+	}
+
+	static bool ValidateParameters(const UFunction* Function, TArrayView<const EParameterType> ExpectedParameters, FResolvedFunction& ResolvedFunction)
+	{
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			const int32 ParameterIndex = ResolvedFunction.Parameters.Num();
+
+			// The prototypes' return values and any extra outputs, like a Blueprint return node's ReturnValue, aren't used
+			if (It->HasAnyPropertyFlags(CPF_ReturnParm) || (ParameterIndex >= ExpectedParameters.Num() && It->HasAnyPropertyFlags(CPF_OutParm)))
+			{
+				continue;
+			}
+
+			if (ParameterIndex >= ExpectedParameters.Num() || !IsParameterOfType(*It, ExpectedParameters[ParameterIndex]))
+			{
+				ResolvedFunction.Parameters.Reset();
+				return false;
+			}
+
+			ResolvedFunction.Parameters.Add(*It);
+		}
+
+		if (ResolvedFunction.Parameters.Num() != ExpectedParameters.Num())
+		{
+			ResolvedFunction.Parameters.Reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	static bool IsResolvedFunctionValid(const FResolvedFunction& ResolvedFunction)
+	{
+		const UFunction* Function = ResolvedFunction.Function.Get();
+
+		if (!Function || Function->HasAnyFlags(RF_NewerVersionExists))
+		{
+			return false;
+		}
+
+#if WITH_EDITOR
+		// Recompiling a Blueprint moves its old functions out of the class
+		if (!Function->GetOuter()->IsA<UClass>())
+		{
+			return false;
+		}
+#endif
+
+		return true;
+	}
+
+	static const FResolvedFunction* ResolveFunction(const USimpleAttributeModifier* OwningModifier, const FMemberReference& DynamicFunction, TArrayView<const EParameterType> ExpectedParameters)
+	{
+		if (!OwningModifier)
+		{
+			return nullptr;
+		}
+
+		UClass* ModifierClass = OwningModifier->GetClass();
+		const FResolvedFunctionKey Key = { ModifierClass, DynamicFunction.GetMemberParentClass(), DynamicFunction.GetMemberName() };
+
+		if (const FResolvedFunction* ResolvedFunction = ResolvedFunctions.Find(Key))
+		{
+			if (IsResolvedFunctionValid(*ResolvedFunction))
+			{
+				return ResolvedFunction->Parameters.Num() > 0 ? ResolvedFunction : nullptr;
+			}
+		}
+
+		UFunction* Function = DynamicFunction.ResolveMember<UFunction>(ModifierClass);
+
+		if (!Function)
+		{
+			// Not cached, the selector may be unset or the function may not be compiled yet
+			return nullptr;
+		}
+
+		INC_DWORD_STAT(STAT_SimpleGAS_SelectorFunctionsResolved);
+
+		FResolvedFunction& ResolvedFunction = ResolvedFunctions.Add(Key);
+		ResolvedFunction.Function = Function;
+
+		if (!ValidateParameters(Function, ExpectedParameters, ResolvedFunction))
+		{
+			UE_LOG(LogSimpleGAS, Error, TEXT("[UFunctionSelectors::ResolveFunction]: The parameters of %s selected in %s don't match the selector's prototype."),
+				*Function->GetPathName(), *ModifierClass->GetName());
+			return nullptr;
+		}
+
+		if (const FNativeFunctions* NativeFunctions = NativeFunctionRegistry.Find({ Function->GetOwnerClass(), Function->GetFName() }))
+		{
+			ResolvedFunction.NativeFunctions = *NativeFunctions;
+		}
+
+		return &ResolvedFunction;
+	}
+
+	static FNativeFunctions& FindOrAddNativeFunctions(const UClass* OwnerClass, const FName FunctionName)
+	{
+		// The registered functions are picked up when a selector is next resolved
+		ResolvedFunctions.Reset();
+		return NativeFunctionRegistry.FindOrAdd({ OwnerClass, FunctionName });
+	}
+
+	/**
+	 * The parameter memory for calling a resolved function with ProcessEvent. Parameters are accessed by their index in the
+	 * prototype. Copies what it needs from the resolved function since the function can resolve other selectors while it runs.
+	 */
+	class FParameters
+	{
+	public:
+		UE_NONCOPYABLE(FParameters);
+
+		explicit FParameters(const FResolvedFunction& ResolvedFunction)
+			: Function(ResolvedFunction.Function.Get())
+			, Parameters(ResolvedFunction.Parameters)
+		{
+			Data = Function->ParmsSize <= sizeof(InlineData)
+				? InlineData
+				: static_cast<uint8*>(FMemory::Malloc(Function->ParmsSize, Function->GetMinAlignment()));
+			FMemory::Memzero(Data, Function->ParmsSize);
+
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				It->InitializeValue_InContainer(Data);
+			}
+		}
+
+		~FParameters()
+		{
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				It->DestroyValue_InContainer(Data);
+			}
+
+			if (Data != InlineData)
+			{
+				FMemory::Free(Data);
+			}
+		}
+
+		void Call(UObject* Object) const
+		{
+			Object->ProcessEvent(Function, Data);
+		}
+
+		template <typename ValueType>
+		ValueType& Value(const int32 ParameterIndex) const
+		{
+			return *Parameters[ParameterIndex]->ContainerPtrToValuePtr<ValueType>(Data);
+		}
+
+		void SetFloat(const int32 ParameterIndex, const float NewValue) const
+		{
+			const FProperty* Property = Parameters[ParameterIndex];
+
+			if (const FDoubleProperty* DoubleProperty = CastField<FDoubleProperty>(Property))
+			{
+				DoubleProperty->SetPropertyValue_InContainer(Data, NewValue);
+				return;
+			}
+
+			CastFieldChecked<FFloatProperty>(Property)->SetPropertyValue_InContainer(Data, NewValue);
+		}
+
+		float GetFloat(const int32 ParameterIndex) const
+		{
+			const FProperty* Property = Parameters[ParameterIndex];
+
+			if (const FDoubleProperty* DoubleProperty = CastField<FDoubleProperty>(Property))
+			{
+				return static_cast<float>(DoubleProperty->GetPropertyValue_InContainer(Data));
+			}
+
+			return CastFieldChecked<FFloatProperty>(Property)->GetPropertyValue_InContainer(Data);
+		}
+
+		void SetAbilityComponent(const int32 ParameterIndex, USimpleGameplayAbilityComponent* NewValue) const
+		{
+			const FObjectPropertyBase* ObjectProperty = CastFieldChecked<FObjectPropertyBase>(Parameters[ParameterIndex]);
+
+			if (!NewValue || NewValue->IsA(ObjectProperty->PropertyClass))
+			{
+				ObjectProperty->SetObjectPropertyValue_InContainer(Data, NewValue);
+			}
+		}
+
+		USimpleGameplayAbilityComponent* GetAbilityComponent(const int32 ParameterIndex) const
+		{
+			return Cast<USimpleGameplayAbilityComponent>(CastFieldChecked<FObjectPropertyBase>(Parameters[ParameterIndex])->GetObjectPropertyValue_InContainer(Data));
+		}
+
+	private:
+		UFunction* Function;
+		TArray<FProperty*, TInlineAllocator<8>> Parameters;
+		uint8* Data = nullptr;
+		alignas(16) uint8 InlineData[256];
+	};
+}
+
+void UFunctionSelectors::RegisterNativeFunction(const UClass* OwnerClass, const FName FunctionName, const FNativeGetCustomFloatInputValue NativeFunction)
+{
+	FunctionSelectors::FindOrAddNativeFunctions(OwnerClass, FunctionName).GetCustomFloatInputValue = NativeFunction;
+}
+
+void UFunctionSelectors::RegisterNativeFunction(const UClass* OwnerClass, const FName FunctionName, const FNativeApplyFloatAttributeOperation NativeFunction)
+{
+	FunctionSelectors::FindOrAddNativeFunctions(OwnerClass, FunctionName).ApplyFloatAttributeOperation = NativeFunction;
+}
+
+void UFunctionSelectors::RegisterNativeFunction(const UClass* OwnerClass, const FName FunctionName, const FNativeModifyStructAttributeValue NativeFunction)
+{
+	FunctionSelectors::FindOrAddNativeFunctions(OwnerClass, FunctionName).ModifyStructAttributeValue = NativeFunction;
+}
+
+void UFunctionSelectors::RegisterNativeFunction(const UClass* OwnerClass, const FName FunctionName, const FNativeGetStructContext NativeFunction)
+{
+	FunctionSelectors::FindOrAddNativeFunctions(OwnerClass, FunctionName).GetStructContext = NativeFunction;
+}
+
+void UFunctionSelectors::RegisterNativeFunction(const UClass* OwnerClass, const FName FunctionName, const FNativeGetAttributeModifierSideEffectTargets NativeFunction)
+{
+	FunctionSelectors::FindOrAddNativeFunctions(OwnerClass, FunctionName).GetAttributeModifierSideEffectTargets = NativeFunction;
+}
+
+void UFunctionSelectors::UnregisterNativeFunction(const UClass* OwnerClass, const FName FunctionName)
+{
+	FunctionSelectors::NativeFunctionRegistry.Remove({ OwnerClass, FunctionName });
+	FunctionSelectors::ResolvedFunctions.Reset();
+}
+
+void UFunctionSelectors::ClearResolvedFunctions()
+{
+	FunctionSelectors::ResolvedFunctions.Reset();
+}
 
 bool UFunctionSelectors::GetCustomFloatInputValue(
 	USimpleAttributeModifier* OwningModifier,
@@ -10,19 +334,25 @@ bool UFunctionSelectors::GetCustomFloatInputValue(
 	const FGameplayTag AttributeTag,
 	float& CustomInputValue)
 {
-	if (UFunction* Function = DynamicFunction.ResolveMember<UFunction>(OwningModifier->GetClass()))
+	using namespace FunctionSelectors;
+	const FResolvedFunction* ResolvedFunction = ResolveFunction(OwningModifier, DynamicFunction, GetCustomFloatInputValueParameters);
+
+	if (!ResolvedFunction)
 	{
-		struct {
-			FGameplayTag AttributeTag;
-			float CustomInputValue;
-		} Params = { AttributeTag, 0.0f };
+		return false;
+	}
 
-		OwningModifier->ProcessEvent(Function, &Params);
-		CustomInputValue = Params.CustomInputValue;
-		return true;
+	if (ResolvedFunction->NativeFunctions.GetCustomFloatInputValue)
+	{
+		return ResolvedFunction->NativeFunctions.GetCustomFloatInputValue(OwningModifier, AttributeTag, CustomInputValue);
 	}
 
-	return false;
+	const FParameters Params(*ResolvedFunction);
+	Params.Value<FGameplayTag>(0) = AttributeTag;
+
+	Params.Call(OwningModifier);
+	CustomInputValue = Params.GetFloat(1);
+	return true;
 }
 
 bool UFunctionSelectors::ApplyFloatAttributeOperation(
@@ -30,29 +360,37 @@ bool UFunctionSelectors::ApplyFloatAttributeOperation(
 	const float CurrentAttributeValue, const float OperationInputValue, const float CurrentOverflow,
 	FGameplayTag& EventTagOverride, float& NewAttributeValue, float& NewOverflow)
 {
-	if (UFunction* Function = DynamicFunction.ResolveMember<UFunction>(OwningModifier->GetClass()))
-	{
-		struct {
-			// Input arguments
-			FGameplayTag AttributeTag;
-			float CurrentAttributeValue;
-			float OperationInputValue;
-			float CurrentOverflow;
-			// Output arguments
-			FGameplayTag EventTagOverride;
-			float NewAttributeValue;
-			float NewOverflow;
-		} Params = { AttributeTag, CurrentAttributeValue, OperationInputValue, CurrentOverflow, EventTagOverride, NewAttributeValue, NewOverflow };
-
-		// Call ProcessEvent on the OwningModifier to set the correct 'this' context
-		OwningModifier->ProcessEvent(Function, &Params);
-		EventTagOverride = Params.EventTagOverride;
-		NewAttributeValue = Params.NewAttributeValue;
-		NewOverflow = Params.NewOverflow;
-		return true;
+	using namespace FunctionSelectors;
+	const FResolvedFunction* ResolvedFunction = ResolveFunction(OwningModifier, DynamicFunction, ApplyFloatAttributeOperationParameters);
+
+	if (!ResolvedFunction)
+	{
+		return false;
 	}
 
-	return false;
+	if (ResolvedFunction->NativeFunctions.ApplyFloatAttributeOperation)
+	{
+		return ResolvedFunction->NativeFunctions.ApplyFloatAttributeOperation(OwningModifier, AttributeTag,
+			CurrentAttributeValue, OperationInputValue, CurrentOverflow, EventTagOverride, NewAttributeValue, NewOverflow);
+	}
+
+	const FParameters Params(*ResolvedFunction);
+	// Input arguments
+	Params.Value<FGameplayTag>(0) = AttributeTag;
+	Params.SetFloat(1, CurrentAttributeValue);
+	Params.SetFloat(2, OperationInputValue);
+	Params.SetFloat(3, CurrentOverflow);
+	// Output arguments
+	Params.Value<FGameplayTag>(4) = EventTagOverride;
+	Params.SetFloat(5, NewAttributeValue);
+	Params.SetFloat(6, NewOverflow);
+
+	// Call ProcessEvent on the OwningModifier to set the correct 'this' context
+	Params.Call(OwningModifier);
+	EventTagOverride = Params.Value<FGameplayTag>(4);
+	NewAttributeValue = Params.GetFloat(5);
+	NewOverflow = Params.GetFloat(6);
+	return true;
 }
 
 bool UFunctionSelectors::ModifyStructAttributeValue(
@@ -62,20 +400,27 @@ bool UFunctionSelectors::ModifyStructAttributeValue(
 	const FInstancedStruct& InStruct,
 	FInstancedStruct& OutStruct)
 {
-	if (UFunction* Function = DynamicFunction.ResolveMember<UFunction>(OwningModifier->GetClass()))
+	using namespace FunctionSelectors;
+	const FResolvedFunction* ResolvedFunction = ResolveFunction(OwningModifier, DynamicFunction, ModifyStructAttributeValueParameters);
+
+	if (!ResolvedFunction)
 	{
-		struct {
-			FGameplayTag AttributeTag;
-			FInstancedStruct InStruct;
-			FInstancedStruct OutStruct;
-		} Params = { AttributeTag, InStruct, OutStruct };
+		return false;
+	}
 
-		OwningModifier->ProcessEvent(Function, &Params);
-		OutStruct = Params.OutStruct;
-		return true;
+	if (ResolvedFunction->NativeFunctions.ModifyStructAttributeValue)
+	{
+		return ResolvedFunction->NativeFunctions.ModifyStructAttributeValue(OwningModifier, AttributeTag, InStruct, OutStruct);
 	}
 
-	return false;
+	const FParameters Params(*ResolvedFunction);
+	Params.Value<FGameplayTag>(0) = AttributeTag;
+	Params.Value<FInstancedStruct>(1) = InStruct;
+	Params.Value<FInstancedStruct>(2) = OutStruct;
+
+	Params.Call(OwningModifier);
+	OutStruct = MoveTemp(Params.Value<FInstancedStruct>(2));
+	return true;
 }
 
 bool UFunctionSelectors::GetStructContext(
@@ -83,18 +428,25 @@ bool UFunctionSelectors::GetStructContext(
 	const FMemberReference& DynamicFunction,
 	FInstancedStruct& Context)
 {
-	if (UFunction* Function = DynamicFunction.ResolveMember<UFunction>(OwningModifier->GetClass()))
+	using namespace FunctionSelectors;
+	const FResolvedFunction* ResolvedFunction = ResolveFunction(OwningModifier, DynamicFunction, GetStructContextParameters);
+
+	if (!ResolvedFunction)
 	{
-		struct {
-			FInstancedStruct Context;
-		} Params = { Context };
+		return false;
+	}
 
-		OwningModifier->ProcessEvent(Function, &Params);
-		Context = Params.Context;
-		return true;
+	if (ResolvedFunction->NativeFunctions.GetStructContext)
+	{
+		return ResolvedFunction->NativeFunctions.GetStructContext(OwningModifier, Context);
 	}
 
-	return false;
+	const FParameters Params(*ResolvedFunction);
+	Params.Value<FInstancedStruct>(0) = Context;
+
+	Params.Call(OwningModifier);
+	Context = MoveTemp(Params.Value<FInstancedStruct>(0));
+	return true;
 }
 
 bool UFunctionSelectors::GetAttributeModifierSideEffectTargets(
@@ -103,18 +455,25 @@ bool UFunctionSelectors::GetAttributeModifierSideEffectTargets(
 	USimpleGameplayAbilityComponent*& OutInstigator,
 	USimpleGameplayAbilityComponent*& OutTarget)
 {
-	if (UFunction* Function = DynamicFunction.ResolveMember<UFunction>(OwningModifier->GetClass()))
+	using namespace FunctionSelectors;
+	const FResolvedFunction* ResolvedFunction = ResolveFunction(OwningModifier, DynamicFunction, GetAttributeModifierSideEffectTargetsParameters);
+
+	if (!ResolvedFunction)
 	{
-		struct {
-			USimpleGameplayAbilityComponent* Instigator;
-			USimpleGameplayAbilityComponent* Target;
-		} Params = { OutInstigator, OutTarget };
+		return false;
+	}
 
-		OwningModifier->ProcessEvent(Function, &Params);
-		OutInstigator = Params.Instigator;
-		OutTarget = Params.Target;
-		return true;
+	if (ResolvedFunction->NativeFunctions.GetAttributeModifierSideEffectTargets)
+	{
+		return ResolvedFunction->NativeFunctions.GetAttributeModifierSideEffectTargets(OwningModifier, OutInstigator, OutTarget);
 	}
 
-	return false;
+	const FParameters Params(*ResolvedFunction);
+	Params.SetAbilityComponent(0, OutInstigator);
+	Params.SetAbilityComponent(1, OutTarget);
+
+	Params.Call(OwningModifier);
+	OutInstigator = Params.GetAbilityComponent(0);
+	OutTarget = Params.GetAbilityComponent(1);
+	return true;
 }
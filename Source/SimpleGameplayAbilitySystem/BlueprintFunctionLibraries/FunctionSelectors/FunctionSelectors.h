@@ -44,6 +44,39 @@ public:
 		USimpleGameplayAbilityComponent*& OutTarget) { return false; }
 #endif
 
+	/**
+	 * C++ versions of the selector prototypes. A native function registered for a UFUNCTION is called directly instead of
+	 * the UFUNCTION going through ProcessEvent whenever a function selector picks that UFUNCTION. Blueprint subclasses that
+	 * override the UFUNCTION still call their override.
+	 */
+	using FNativeGetCustomFloatInputValue = bool (*)(USimpleAttributeModifier* OwningModifier, FGameplayTag AttributeTag, float& CustomInputValue);
+	using FNativeApplyFloatAttributeOperation = bool (*)(USimpleAttributeModifier* OwningModifier, FGameplayTag AttributeTag,
+		float CurrentAttributeValue, float OperationInputValue, float CurrentOverflow,
+		FGameplayTag& EventTagOverride, float& NewAttributeValue, float& NewOverflow);
+	using FNativeModifyStructAttributeValue = bool (*)(USimpleAttributeModifier* OwningModifier, FGameplayTag AttributeTag, const FInstancedStruct& InStruct, FInstancedStruct& OutStruct);
+	using FNativeGetStructContext = bool (*)(USimpleAttributeModifier* OwningModifier, FInstancedStruct& Context);
+	using FNativeGetAttributeModifierSideEffectTargets = bool (*)(USimpleAttributeModifier* OwningModifier,
+		USimpleGameplayAbilityComponent*& OutInstigator, USimpleGameplayAbilityComponent*& OutTarget);
+
+	/**
+	 * Registers a native function for the UFUNCTION named FunctionName declared in OwnerClass, e.g. from StartupModule.
+	 * The native function should do the same thing as the UFUNCTION.
+	 */
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API void RegisterNativeFunction(const UClass* OwnerClass, FName FunctionName, FNativeGetCustomFloatInputValue NativeFunction);
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API void RegisterNativeFunction(const UClass* OwnerClass, FName FunctionName, FNativeApplyFloatAttributeOperation NativeFunction);
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API void RegisterNativeFunction(const UClass* OwnerClass, FName FunctionName, FNativeModifyStructAttributeValue NativeFunction);
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API void RegisterNativeFunction(const UClass* OwnerClass, FName FunctionName, FNativeGetStructContext NativeFunction);
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API void RegisterNativeFunction(const UClass* OwnerClass, FName FunctionName, FNativeGetAttributeModifierSideEffectTargets NativeFunction);
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API void UnregisterNativeFunction(const UClass* OwnerClass, FName FunctionName);
+
+	/* Clears the resolved selector functions, e.g. after Blueprint classes were recompiled */
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API void ClearResolvedFunctions();
+
+	/**
+	 * The Get/Apply/Modify functions below resolve the selected function once per modifier class and function selector
+	 * and check that its parameters match the prototype. They return false if the function can't be resolved or doesn't match.
+	 */
+
 	static bool GetCustomFloatInputValue(
 		USimpleAttributeModifier* OwningModifier,
 		const FMemberReference& DynamicFunction,
@@ -7,6 +7,7 @@
 #define LOCTEXT_NAMESPACE "FSimpleGameplayAbilitySystemModule"
 
 DEFINE_LOG_CATEGORY(LogSimpleGAS);
+CSV_DEFINE_CATEGORY_MODULE(SIMPLEGAMEPLAYABILITYSYSTEM_API, SimpleGAS, true);
 
 void FSimpleGameplayAbilitySystemModule::StartupModule()
 {
@@ -4,9 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 SIMPLEGAMEPLAYABILITYSYSTEM_API DECLARE_LOG_CATEGORY_EXTERN(LogSimpleGAS, Log, All);
 
+// "stat SimpleGAS" in the console shows the stats of this group
+DECLARE_STATS_GROUP(TEXT("SimpleGAS"), STATGROUP_SimpleGAS, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(SIMPLEGAMEPLAYABILITYSYSTEM_API, SimpleGAS);
+
 static void SIMPLE_LOG(const UObject* WorldContext, FString Msg)
 {
 	if (!ensure(WorldContext))
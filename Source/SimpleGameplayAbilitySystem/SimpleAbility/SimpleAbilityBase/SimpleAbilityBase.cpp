@@ -1,19 +1,56 @@
 ﻿#include "SimpleAbilityBase.h"
 
+#include "TimerManager.h"
+#include "Engine/World.h"
 #include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubsystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
 
 void USimpleAbilityBase::InitializeAbility(USimpleGameplayAbilityComponent* InOwningAbilityComponent, FGuid InAbilityInstanceID, bool IsProxyActivation)
 {
+	const FGuid OldInstanceID = AbilityInstanceID;
+
 	OwningAbilityComponent = InOwningAbilityComponent;
 	AbilityInstanceID = InAbilityInstanceID;
 	IsProxyAbility = IsProxyActivation;
+
+	if (OwningAbilityComponent)
+	{
+		OwningAbilityComponent->UpdateInstanceID(this, OldInstanceID);
+	}
 }
 
 void USimpleAbilityBase::CleanUpAbility_Implementation()
 {
 }
 
+void USimpleAbilityBase::ResetAbility_Implementation()
+{
+	AbilityInstanceID.Invalidate();
+	IsProxyAbility = false;
+	SnapshotSequenceCounter = 0;
+	SnapshotResolveCallbacks.Empty();
+	ClearPendingCallbacks();
+}
+
+void USimpleAbilityBase::ClearPendingCallbacks()
+{
+	UWorld* World = GetWorld();
+
+	if (!World)
+	{
+		return;
+	}
+
+	if (USimpleEventSubsystem* EventSubsystem = World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>() : nullptr)
+	{
+		EventSubsystem->StopListeningForAllEvents(this);
+	}
+
+	World->GetTimerManager().ClearAllTimersForObject(this);
+	World->GetLatentActionManager().RemoveActionsForObject(this);
+}
+
 void USimpleAbilityBase::TakeStateSnapshot(FGameplayTag SnapshotTag, FInstancedStruct SnapshotData, const FOnSnapshotResolved& OnResolved)
 {
 	if (!OwningAbilityComponent)
@@ -26,6 +26,14 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	bool IsProxyAbility = false;
 
+	/**
+	 * The most snapshots kept in the state of this ability, older snapshots are removed first. Clients only remove
+	 * snapshots they've resolved. The server also removes snapshots once the owning client has resolved them. The whole history is sent every time a snapshot is taken, so
+	 * only raise this for abilities that take many snapshots faster than they can be resolved.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Snapshot", meta = (ClampMin = 1))
+	int32 MaxSnapshotHistory = 8;
+
 	UFUNCTION(BlueprintCallable)
 	void InitializeAbility(USimpleGameplayAbilityComponent* InOwningAbilityComponent, FGuid InAbilityInstanceID, bool IsProxyActivation);
 
@@ -37,6 +45,17 @@ public:
 	UFUNCTION(BlueprintNativeEvent)
 	void CleanUpAbility();
 	virtual void CleanUpAbility_Implementation();
+
+	/**
+	 * Called before a pooled instance is reused for a new activation (see USimpleGameplayAbility::AllowInstancePooling).
+	 * Reset any variables you set during an activation here so the instance starts out like a newly created one.
+	 */
+	UFUNCTION(BlueprintNativeEvent)
+	void ResetAbility();
+	virtual void ResetAbility_Implementation();
+
+	// Stops the event subscriptions, timers and latent actions of this instance, called when it's pooled and when it's reset
+	void ClearPendingCallbacks();
 	
 	UFUNCTION(BlueprintCallable, Category = "Ability|Snapshot")
 	void TakeStateSnapshot(FGameplayTag SnapshotTag, FInstancedStruct SnapshotData, const FOnSnapshotResolved& OnResolved);
@@ -194,6 +194,10 @@ struct FAbilityState : public FFastArraySerializerItem
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	TArray<FSimpleAbilitySnapshot> SnapshotHistory;
 
+	// Server time when the ability ended, used to remove ended states after a while
+	UPROPERTY(NotReplicated)
+	double EndedTimeStamp = 0.0;
+
 	bool operator==(const FAbilityState& Other) const
 	{
 		return AbilityID == Other.AbilityID;
@@ -264,6 +268,105 @@ struct TStructOpsTypeTraits<FAbilityStateContainer> : public TStructOpsTypeTrait
 	};
 };
 
+/* Ended instances of a MultipleInstances ability class waiting to be reused, see USimpleGameplayAbility::AllowInstancePooling */
+USTRUCT()
+struct FAbilityInstancePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<USimpleGameplayAbility>> Instances;
+};
+
+/* Ended instances of an attribute modifier class waiting to be reused, see USimpleGameplayAbilityComponent::MaxPooledAttributeModifierInstances */
+USTRUCT()
+struct FAttributeModifierInstancePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<USimpleAttributeModifier>> Instances;
+};
+
+/**
+ * Maps ability IDs to their index in an ability state array. Like FAttributeTagIndex, lookups check that the state at
+ * the index still has the ID and rebuild the index if it doesn't, so replicated arrays that change without going
+ * through the index stay correct.
+ */
+struct FAbilityStateIndex
+{
+	FAbilityState* Find(TArray<FAbilityState>& AbilityStates, const FGuid& AbilityID)
+	{
+		if (const int32* StateIndex = Indices.Find(AbilityID))
+		{
+			if (AbilityStates.IsValidIndex(*StateIndex) && AbilityStates[*StateIndex].AbilityID == AbilityID)
+			{
+				return &AbilityStates[*StateIndex];
+			}
+		}
+		else if (IndexedNum == AbilityStates.Num())
+		{
+			return nullptr;
+		}
+
+		Rebuild(AbilityStates);
+
+		const int32* StateIndex = Indices.Find(AbilityID);
+		return StateIndex ? &AbilityStates[*StateIndex] : nullptr;
+	}
+
+	/* Adds the state to the end of the array. Doesn't check whether the array already contains a state with the same ID. */
+	FAbilityState& Add(TArray<FAbilityState>& AbilityStates, const FAbilityState& AbilityState)
+	{
+		const int32 StateIndex = AbilityStates.Add(AbilityState);
+		Indices.Add(AbilityState.AbilityID, StateIndex);
+		IndexedNum = AbilityStates.Num();
+		return AbilityStates[StateIndex];
+	}
+
+	/* Removes the state by swapping the last state into its place. Returns false if there was no state with the ID. */
+	bool Remove(TArray<FAbilityState>& AbilityStates, const FGuid& AbilityID)
+	{
+		FAbilityState* AbilityState = Find(AbilityStates, AbilityID);
+
+		if (!AbilityState)
+		{
+			return false;
+		}
+
+		const int32 StateIndex = static_cast<int32>(AbilityState - AbilityStates.GetData());
+		Indices.Remove(AbilityID);
+		AbilityStates.RemoveAtSwap(StateIndex);
+
+		if (AbilityStates.IsValidIndex(StateIndex))
+		{
+			Indices.Add(AbilityStates[StateIndex].AbilityID, StateIndex);
+		}
+
+		IndexedNum = AbilityStates.Num();
+		return true;
+	}
+
+	void Rebuild(const TArray<FAbilityState>& AbilityStates)
+	{
+		Indices.Reset();
+
+		// Iterate backwards so the first state with an ID wins if there are duplicates, like it did when scanning the array
+		for (int32 StateIndex = AbilityStates.Num() - 1; StateIndex >= 0; --StateIndex)
+		{
+			Indices.Add(AbilityStates[StateIndex].AbilityID, StateIndex);
+		}
+
+		IndexedNum = AbilityStates.Num();
+	}
+
+private:
+	TMap<FGuid, int32> Indices;
+
+	// The size of the array when the index was last updated
+	int32 IndexedNum = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FSimpleAbilityEndedEvent
 {
@@ -1,14 +1,23 @@
 #include "SimpleAttributeModifier.h"
 
+#include "SimpleModifierScheduler.h"
 #include "SimpleGameplayAbilitySystem/BlueprintFunctionLibraries/FunctionSelectors/FunctionSelectors.h"
 #include "SimpleGameplayAbilitySystem/DefaultTags/DefaultTags.h"
 #include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleGameplayAbility/SimpleGameplayAbility.h"
 #include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubSystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
+#include "HAL/IConsoleManager.h"
 
 class USimpleEventSubsystem;
 
+static bool GSimpleGASUseCompiledModifierPrograms = true;
+static FAutoConsoleVariableRef CVarSimpleGASUseCompiledModifierPrograms(
+	TEXT("SimpleGAS.Modifiers.UseCompiledPrograms"),
+	GSimpleGASUseCompiledModifierPrograms,
+	TEXT("If true (default), float attribute modifications run from a program compiled once per modifier class.\n")
+	TEXT("If false, every application interprets the modifier's FloatAttributeModifications. Useful for debugging and for modifiers that change FloatAttributeModifications at runtime."));
+
 bool USimpleAttributeModifier::CanApplyModifierInternal(FInstancedStruct ModifierContext) const
 {
 	if (!InstigatorAbilityComponent)
@@ -23,13 +32,24 @@ bool USimpleAttributeModifier::CanApplyModifierInternal(FInstancedStruct Modifie
 		return false;
 	}
 	
-	if (!TargetAbilityComponent->HasAllGameplayTags(TargetRequiredTags))
+	// Pause and cancel checks call this on every tick, so use the class default masks if the target keeps a tag bit set
+	const USimpleAttributeModifier* TagMaskDefaults = TargetAbilityComponent->UseGameplayTagBitSet ? GetDefaultsWithTargetTagMasks() : nullptr;
+
+	const bool HasRequiredTags = TagMaskDefaults
+		? TargetAbilityComponent->HasAllGameplayTags(TagMaskDefaults->TargetRequiredTagMask)
+		: TargetAbilityComponent->HasAllGameplayTags(TargetRequiredTags);
+
+	if (!HasRequiredTags)
 	{
 		UE_LOG(LogSimpleGAS, Warning, TEXT("Target does not have required tags in USimpleAttributeModifier::CanApplyModifierInternal"));
 		return false;
 	}
 	
-	if (TargetAbilityComponent->HasAnyGameplayTags(TargetBlockingTags))
+	const bool HasBlockingTags = TagMaskDefaults
+		? TargetAbilityComponent->HasAnyGameplayTags(TagMaskDefaults->TargetBlockingTagMask)
+		: TargetAbilityComponent->HasAnyGameplayTags(TargetBlockingTags);
+
+	if (HasBlockingTags)
 	{
 		UE_LOG(LogSimpleGAS, Warning, TEXT("Target has blocking tags in USimpleAttributeModifier::CanApplyModifierInternal"));
 		return false;
@@ -44,17 +64,197 @@ bool USimpleAttributeModifier::CanApplyModifierInternal(FInstancedStruct Modifie
 	return true;
 }
 
+const USimpleAttributeModifier* USimpleAttributeModifier::GetDefaultsWithTargetTagMasks() const
+{
+	const USimpleAttributeModifier* ModifierDefaults = GetClass()->GetDefaultObject<USimpleAttributeModifier>();
+
+	if (!ModifierDefaults->TargetRequiredTagMask.IsUpToDate())
+	{
+		ModifierDefaults->TargetRequiredTagMask = FGameplayTagBitMask(ModifierDefaults->TargetRequiredTags);
+		ModifierDefaults->TargetBlockingTagMask = FGameplayTagBitMask(ModifierDefaults->TargetBlockingTags);
+	}
+
+	return ModifierDefaults;
+}
+
 bool USimpleAttributeModifier::CanApplyModifier_Implementation(FInstancedStruct ModifierContext) const
 {
 	return true;
 }
 
+const FSimpleInstantModifierSpec* USimpleAttributeModifier::GetInstantModifierSpec(const TSubclassOf<USimpleAttributeModifier> ModifierClass)
+{
+	if (!ModifierClass)
+	{
+		return nullptr;
+	}
+
+	const USimpleAttributeModifier* ModifierDefaults = ModifierClass.GetDefaultObject();
+
+	if (!ModifierDefaults->bIsInstantModifierSpecBuilt)
+	{
+		ModifierDefaults->BuildInstantModifierSpec();
+		ModifierDefaults->bIsInstantModifierSpecBuilt = true;
+	}
+
+	return ModifierDefaults->InstantModifierSpec.ModifierClass ? &ModifierDefaults->InstantModifierSpec : nullptr;
+}
+
+#if WITH_EDITOR
+void USimpleAttributeModifier::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Editing the class defaults invalidates anything compiled from them. Recompiling a Blueprint creates a new class
+	// default object, which starts out with nothing built.
+	bIsInstantModifierSpecBuilt = false;
+	bIsFloatModifierProgramBuilt = false;
+
+	// The net indices didn't change, so the masks would still count as up to date
+	TargetRequiredTagMask = FGameplayTagBitMask(TargetRequiredTags);
+	TargetBlockingTagMask = FGameplayTagBitMask(TargetBlockingTags);
+}
+#endif
+
+void USimpleAttributeModifier::BuildInstantModifierSpec() const
+{
+	InstantModifierSpec = FSimpleInstantModifierSpec();
+
+	if (ModifierType != EAttributeModifierType::Instant)
+	{
+		return;
+	}
+
+	const bool NeedsInstance = StructAttributeModifications.Num() > 0
+		|| AbilitySideEffects.Num() > 0
+		|| EventSideEffects.Num() > 0
+		|| AttributeModifierSideEffects.Num() > 0
+		|| CancelAbilities.Num() > 0
+		|| !CancelAbilitiesWithAbilityTags.IsEmpty()
+		|| !CancelModifiersWithTag.IsEmpty()
+		|| !PermanentlyAppliedTags.IsEmpty()
+		|| !RemoveGameplayTags.IsEmpty();
+
+	if (NeedsInstance)
+	{
+		return;
+	}
+
+	const UClass* ModifierClass = GetClass();
+	const FName BlueprintHooks[] = {
+		GET_FUNCTION_NAME_CHECKED(USimpleAttributeModifier, CanApplyModifier),
+		GET_FUNCTION_NAME_CHECKED(USimpleAttributeModifier, OnPreApplyModifier),
+		GET_FUNCTION_NAME_CHECKED(USimpleAttributeModifier, OnPostApplyModifier),
+		GET_FUNCTION_NAME_CHECKED(USimpleAttributeModifier, OnModifierEnded),
+	};
+
+	for (const FName& BlueprintHook : BlueprintHooks)
+	{
+		if (ModifierClass->IsFunctionImplementedInScript(BlueprintHook))
+		{
+			return;
+		}
+	}
+
+	// Native overrides don't show up above, so native subclasses have to confirm they don't have any
+	const UClass* NativeClass = ModifierClass;
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	if (NativeClass != USimpleAttributeModifier::StaticClass() && NativeClass != InstantModifierSpecNativeClass)
+	{
+		return;
+	}
+
+	TArray<FSimpleInstantFloatModification> FloatModifications;
+	FloatModifications.Reserve(FloatAttributeModifications.Num());
+
+	for (const FFloatAttributeModifier& FloatModifier : FloatAttributeModifications)
+	{
+		if (FloatModifier.ModificationInputValueSource == EAttributeModificationValueSource::CustomInputValue ||
+			FloatModifier.ModificationOperation == EFloatAttributeModificationOperation::Custom)
+		{
+			return;
+		}
+
+		FSimpleInstantFloatModification& FloatModification = FloatModifications.AddDefaulted_GetRef();
+		FloatModification.AttributeToModify = FloatModifier.AttributeToModify;
+		FloatModification.IfAttributeNotFound = FloatModifier.IfAttributeNotFound;
+		FloatModification.ModifiedAttributeValueType = FloatModifier.ModifiedAttributeValueType;
+		FloatModification.ModificationInputValueSource = FloatModifier.ModificationInputValueSource;
+		FloatModification.ManualInputValue = FloatModifier.ManualInputValue;
+		FloatModification.SourceAttribute = FloatModifier.SourceAttribute;
+		FloatModification.SourceAttributeValueType = FloatModifier.SourceAttributeValueType;
+		FloatModification.ConsumeOverflow = FloatModifier.ConsumeOverflow;
+		FloatModification.ModificationOperation = FloatModifier.ModificationOperation;
+	}
+
+	InstantModifierSpec.ModifierClass = GetClass();
+	InstantModifierSpec.ModifierApplicationPolicy = ModifierApplicationPolicy;
+	InstantModifierSpec.TargetRequiredTags = TargetRequiredTags;
+	InstantModifierSpec.TargetBlockingTags = TargetBlockingTags;
+	InstantModifierSpec.FloatModifications = MoveTemp(FloatModifications);
+}
+
+const FSimpleFloatModifierProgram* USimpleAttributeModifier::GetFloatModifierProgram(const TSubclassOf<USimpleAttributeModifier> ModifierClass)
+{
+	if (!ModifierClass)
+	{
+		return nullptr;
+	}
+
+	const USimpleAttributeModifier* ModifierDefaults = ModifierClass.GetDefaultObject();
+
+	if (!ModifierDefaults->bIsFloatModifierProgramBuilt)
+	{
+		ModifierDefaults->BuildFloatModifierProgram();
+		ModifierDefaults->bIsFloatModifierProgramBuilt = true;
+	}
+
+	return &ModifierDefaults->FloatModifierProgram;
+}
+
+void USimpleAttributeModifier::BuildFloatModifierProgram() const
+{
+	static_assert(static_cast<uint32>(EAttributeModifierSideEffectTrigger::OnDurationModifierTickCancel) < 32, "PhaseMask needs a bit for every EAttributeModifierSideEffectTrigger");
+
+	FloatModifierProgram = FSimpleFloatModifierProgram();
+	FloatModifierProgram.Instructions.Reserve(FloatAttributeModifications.Num());
+
+	for (int32 ModificationIndex = 0; ModificationIndex < FloatAttributeModifications.Num(); ModificationIndex++)
+	{
+		const FFloatAttributeModifier& FloatModifier = FloatAttributeModifications[ModificationIndex];
+		FSimpleFloatModifierInstruction& Instruction = FloatModifierProgram.Instructions.AddDefaulted_GetRef();
+
+		for (const EAttributeModifierSideEffectTrigger Phase : FloatModifier.ApplicationRequirements)
+		{
+			Instruction.PhaseMask |= 1u << static_cast<uint32>(Phase);
+		}
+
+		Instruction.ModificationIndex = ModificationIndex;
+		Instruction.AttributeSlot = FloatModifierProgram.AttributeSlots.AddUnique(FloatModifier.AttributeToModify);
+		Instruction.ModifiedAttributeValueType = FloatModifier.ModifiedAttributeValueType;
+		Instruction.ModificationInputValueSource = FloatModifier.ModificationInputValueSource;
+		Instruction.ModificationOperation = FloatModifier.ModificationOperation;
+		Instruction.SourceAttributeValueType = FloatModifier.SourceAttributeValueType;
+		Instruction.CancelIfAttributeNotFound = FloatModifier.IfAttributeNotFound == EAttributeModiferNotFoundBehaviour::CancelModifier;
+		Instruction.ConsumeOverflow = FloatModifier.ConsumeOverflow;
+		Instruction.UsesCustomFunction = FloatModifier.ModificationInputValueSource == EAttributeModificationValueSource::CustomInputValue ||
+			FloatModifier.ModificationOperation == EFloatAttributeModificationOperation::Custom;
+		Instruction.ManualInputValue = FloatModifier.ManualInputValue;
+		Instruction.SourceAttribute = FloatModifier.SourceAttribute;
+	}
+}
+
 bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* Instigator, USimpleGameplayAbilityComponent* Target, FInstancedStruct ModifierContext)
 {
 	if (!OwningAbilityComponent->HasAuthority())
 	{
 		if (ModifierApplicationPolicy == EAttributeModifierApplicationPolicy::ApplyServerOnly || ModifierApplicationPolicy == EAttributeModifierApplicationPolicy::ApplyServerOnlyButReplicateSideEffects)
 		{
+			OwningAbilityComponent->ReleaseAttributeModifierInstance(this);
 			return false;
 		}	
 	}
@@ -66,6 +266,7 @@ bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* In
 	if (!Instigator || !Target)
 	{
 		SIMPLE_LOG(this, TEXT("[USimpleAttributeModifier::ApplyModifier]: Instigator or Target is null."));
+		OwningAbilityComponent->ReleaseAttributeModifierInstance(this);
 		return false;
 	}
 	
@@ -101,13 +302,10 @@ bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* In
 			EventTags.AddTag(FDefaultTags::GameplayTagAdded());
 			EventTags.AddTag(FDefaultTags::GameplayTagRemoved());
     
-			FSimpleEventDelegate EventDelegate;
-			EventDelegate.BindDynamic(this, &USimpleAttributeModifier::OnTagsChanged);
-		
-			TArray<UObject*> SenderFilter;
-			SenderFilter.Add(Target->GetAvatarActor());
+			UObject* SenderFilter[] = { Target->GetAvatarActor() };
     
-			EventSubsystem->ListenForEvent(this, false, EventTags, FGameplayTagContainer(), EventDelegate, TArray<UScriptStruct*>(), SenderFilter);
+			EventSubsystem->ListenForEvent(this, false, EventTags, FGameplayTagContainer(),
+				FSimpleNativeEventDelegate::CreateUObject(this, &USimpleAttributeModifier::OnTagsChanged), {}, SenderFilter);
 		}
 		
 		for (const FGameplayTag& Tag : TemporarilyAppliedTags)
@@ -115,53 +313,11 @@ bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* In
 			TargetAbilityComponent->AddGameplayTag(Tag, FInstancedStruct());
 		}
 
-		// If the whole modifier has a duration we set a timer to end it
-		if (Duration > 0 && !HasInfiniteDuration)
+		// The world's modifier scheduler ends the modifier after its duration and calls OnScheduledTick every TickInterval
+		if (USimpleModifierScheduler* ModifierScheduler = GetModifierScheduler())
 		{
-			Instigator->GetWorld()->GetTimerManager().SetTimer(
-				DurationTimerHandle,
-				[this]()
-				{
-					EndModifier(FDefaultTags::AbilityEndedSuccessfully(), FInstancedStruct());
-				},
-				Duration,
-				false
-			);	
-		}
-
-		if (TickInterval > 0)
-		{
-			Instigator->GetWorld()->GetTimerManager().SetTimer(
-				TickTimerHandle,
-				[this]()
-				{
-					if (!CanApplyModifierInternal(InitialModifierContext))
-					{
-						switch (TickTagRequirementBehaviour)
-						{
-							case EDurationTickTagRequirementBehaviour::CancelOnTagRequirementFailed:
-								ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickCancel);
-								EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
-								return;
-							case EDurationTickTagRequirementBehaviour::SkipOnTagRequirementFailed:
-								UE_LOG(LogSimpleGAS, Warning, TEXT("[USimpleAttributeModifier::ApplyModifier]: tag requirement failed on tick. Skipping modification."));
-								return;
-							case EDurationTickTagRequirementBehaviour::PauseOnTagRequirementFailed:
-								InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(DurationTimerHandle);
-								InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(TickTimerHandle);
-								return;
-						}
-					}
-
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(DurationTimerHandle);
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(TickTimerHandle);
-					
-					ApplyModifiersInternal(EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
-					ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
-				},
-				TickInterval,
-				true
-			);
+			const double ScheduledDuration = Duration > 0 && !HasInfiniteDuration ? Duration : 0.0;
+			ModifierScheduler->ScheduleModifier(this, TargetAbilityComponent, ScheduledDuration, TickInterval);
 		}
 
 		if (TickOnApply)
@@ -189,28 +345,34 @@ bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* In
 bool USimpleAttributeModifier::ApplyModifiersInternal(const EAttributeModifierSideEffectTrigger TriggerPhase)
 {
 	// We process the modifier stack as a transaction to avoid partial changes of attributes
-	TArray<FFloatAttribute> TempFloatAttributes = TargetAbilityComponent->AuthorityFloatAttributes.Attributes;
-	TArray<FStructAttribute> TempStructAttributes = TargetAbilityComponent->AuthorityStructAttributes.Attributes;
-
-	TArray<FGameplayTag> ModifiedFloatAttributes;
-	TArray<FGameplayTag> ModifiedStructAttributes;
+	FSimpleAttributeTransaction Transaction(TargetAbilityComponent);
 
 	float CurrentFloatModifierOverflow = 0;
 
-	for (const FFloatAttributeModifier& FloatModifier : FloatAttributeModifications)
+	if (GSimpleGASUseCompiledModifierPrograms)
 	{
-		if (ModifierType == EAttributeModifierType::Duration && !FloatModifier.ApplicationRequirements.Contains(TriggerPhase))
-		{
-			continue;
-		}
-
-		if (ApplyFloatAttributeModifier(FloatModifier, TempFloatAttributes, CurrentFloatModifierOverflow))
+		if (!RunFloatModifierProgram(*GetFloatModifierProgram(GetClass()), TriggerPhase, Transaction, CurrentFloatModifierOverflow))
 		{
-			ModifiedFloatAttributes.Add(FloatModifier.AttributeToModify);
+			return false;
 		}
-		else if (FloatModifier.IfAttributeNotFound == EAttributeModiferNotFoundBehaviour::CancelModifier)
+	}
+	else
+	{
+		for (const FFloatAttributeModifier& FloatModifier : FloatAttributeModifications)
 		{
-			return false;
+			if (ModifierType == EAttributeModifierType::Duration && !FloatModifier.ApplicationRequirements.Contains(TriggerPhase))
+			{
+				continue;
+			}
+
+			if (ApplyFloatAttributeModifier(FloatModifier, Transaction, CurrentFloatModifierOverflow))
+			{
+				Transaction.MarkFloatAttributeModified(FloatModifier.AttributeToModify);
+			}
+			else if (FloatModifier.IfAttributeNotFound == EAttributeModiferNotFoundBehaviour::CancelModifier)
+			{
+				return false;
+			}
 		}
 	}
 	
@@ -221,9 +383,9 @@ bool USimpleAttributeModifier::ApplyModifiersInternal(const EAttributeModifierSi
 			continue;
 		}
 		
-		if (ApplyStructAttributeModifier(StructModifier, TempStructAttributes))
+		if (ApplyStructAttributeModifier(StructModifier, Transaction))
 		{
-			ModifiedStructAttributes.Add(StructModifier.AttributeToModify);
+			Transaction.MarkStructAttributeModified(StructModifier.AttributeToModify);
 		}
 		else if (StructModifier.IfAttributeNotFound == EAttributeModiferNotFoundBehaviour::CancelModifier)
 		{
@@ -234,21 +396,7 @@ bool USimpleAttributeModifier::ApplyModifiersInternal(const EAttributeModifierSi
 	// If all the modifiers were applied successfully, we update the target ability component's attributes
 	if (InstigatorAbilityComponent->HasAuthority())
 	{
-		for (const FFloatAttribute& Attribute : TempFloatAttributes)
-		{
-			if (ModifiedFloatAttributes.Contains(Attribute.AttributeTag))
-			{
-				TargetAbilityComponent->OverrideFloatAttribute(Attribute.AttributeTag, Attribute);
-			}
-		}
-
-		for (const FStructAttribute& Attribute : TempStructAttributes)
-		{
-			if (ModifiedStructAttributes.Contains(Attribute.AttributeTag))
-			{
-				TargetAbilityComponent->SetStructAttributeValue(Attribute.AttributeTag, Attribute.AttributeValue);
-			}
-		}
+		Transaction.Commit();
 	}
 	
 	return true;
@@ -256,8 +404,10 @@ bool USimpleAttributeModifier::ApplyModifiersInternal(const EAttributeModifierSi
 
 void USimpleAttributeModifier::EndModifier(const FGameplayTag EndingStatus, const FInstancedStruct EndingContext)
 {
-	InstigatorAbilityComponent->GetWorld()->GetTimerManager().ClearTimer(DurationTimerHandle);
-	InstigatorAbilityComponent->GetWorld()->GetTimerManager().ClearTimer(TickTimerHandle);
+	if (USimpleModifierScheduler* ModifierScheduler = GetModifierScheduler())
+	{
+		ModifierScheduler->UnscheduleModifier(this);
+	}
 
 	if (USimpleEventSubsystem* EventSubsystem = InstigatorAbilityComponent->GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>())
 	{
@@ -306,6 +456,13 @@ void USimpleAttributeModifier::EndModifier(const FGameplayTag EndingStatus, cons
 	
 	OnModifierEnded(EndingStatus, EndingContext);
 	bIsModifierActive = false;
+
+	// A client predicted instance isn't needed to resolve its snapshots, the server's state has its own ID and
+	// OnStateChanged resolves it with a separate instance
+	if (OwningAbilityComponent)
+	{
+		OwningAbilityComponent->ReleaseAttributeModifierInstance(this);
+	}
 }
 
 void USimpleAttributeModifier::CleanUpAbility_Implementation()
@@ -332,6 +489,22 @@ void USimpleAttributeModifier::CleanUpAbility_Implementation()
 	Super::CleanUpAbility_Implementation();
 }
 
+void USimpleAttributeModifier::ResetAbility_Implementation()
+{
+	if (USimpleModifierScheduler* ModifierScheduler = GetModifierScheduler())
+	{
+		ModifierScheduler->UnscheduleModifier(this);
+	}
+
+	bIsModifierActive = false;
+	InitialModifierContext.Reset();
+	InstigatorAbilityComponent = nullptr;
+	TargetAbilityComponent = nullptr;
+	Stacks = GetClass()->GetDefaultObject<USimpleAttributeModifier>()->Stacks;
+
+	Super::ResetAbility_Implementation();
+}
+
 void USimpleAttributeModifier::AddModifierStack(int32 StackCount)
 {
 	if (!CanStack)
@@ -354,9 +527,9 @@ void USimpleAttributeModifier::AddModifierStack(int32 StackCount)
 	OnStacksAdded(StackCount, Stacks);
 }
 
-bool USimpleAttributeModifier::ApplyFloatAttributeModifier(const FFloatAttributeModifier& FloatModifier, TArray<FFloatAttribute>& TempFloatAttributes, float& CurrentOverflow)
+bool USimpleAttributeModifier::ApplyFloatAttributeModifier(const FFloatAttributeModifier& FloatModifier, FSimpleAttributeTransaction& Transaction, float& CurrentOverflow)
 {
-	FFloatAttribute* AttributeToModify = GetTempFloatAttribute(FloatModifier.AttributeToModify, TempFloatAttributes);
+	FFloatAttribute* AttributeToModify = Transaction.GetFloatAttribute(FloatModifier.AttributeToModify);
 	
 	if (!AttributeToModify)
 	{
@@ -437,116 +610,255 @@ bool USimpleAttributeModifier::ApplyFloatAttributeModifier(const FFloatAttribute
 	}
 
 	// Next up we get the current value of the attribute
-	float CurrentAttributeValue = 0;
-	switch (FloatModifier.ModifiedAttributeValueType)
+	const float CurrentAttributeValue = GetFloatAttributeValueOfType(*AttributeToModify, FloatModifier.ModifiedAttributeValueType);
+	
+	// Next, modify AttributeToModify based on the input value and the modifier's operation
+	float NewAttributeValue = 0;
+	FGameplayTag FloatChangedDomainTag = AttributeToModify->AttributeTag;
+	if (FloatModifier.ModificationOperation == EFloatAttributeModificationOperation::Custom)
+	{
+		if (!UFunctionSelectors::ApplyFloatAttributeOperation(
+			this,
+			FloatModifier.FloatOperationFunction,
+			AttributeToModify->AttributeTag,
+			CurrentAttributeValue,
+			ModificationInputValue,
+			CurrentOverflow,
+			FloatChangedDomainTag,
+			NewAttributeValue,
+			CurrentOverflow))
+		{
+			SIMPLE_LOG(OwningAbilityComponent, FString::Printf(TEXT("[USimpleAttributeModifier::ApplyFloatAttributeModifier]: Custom operation function %s failed to activate."), *FloatModifier.CustomInputFunction.GetMemberName().ToString()));
+			return false;
+		}
+	}
+	else if (!ApplyFloatOperation(FloatModifier.ModificationOperation, CurrentAttributeValue, ModificationInputValue, NewAttributeValue))
+	{
+		SIMPLE_LOG(OwningAbilityComponent, TEXT("[USimpleAttributeModifier::ApplyFloatAttributeModifier]: Division by zero."));
+		return false;
+	}
+
+	// Lastly, we set the new value to the attribute
+	SetFloatAttributeValueOfType(*AttributeToModify, FloatModifier.ModifiedAttributeValueType, NewAttributeValue, CurrentOverflow);
+	
+	return true;
+}
+
+float USimpleAttributeModifier::GetFloatAttributeValueOfType(const FFloatAttribute& Attribute, const EAttributeValueType ValueType)
+{
+	switch (ValueType)
 	{
 		case EAttributeValueType::BaseValue:
-			CurrentAttributeValue = AttributeToModify->BaseValue;
-			break;
+			return Attribute.BaseValue;
 		case EAttributeValueType::MinBaseValue:
-			CurrentAttributeValue = AttributeToModify->ValueLimits.MinBaseValue;
-			break;
+			return Attribute.ValueLimits.MinBaseValue;
 		case EAttributeValueType::MaxBaseValue:
-			CurrentAttributeValue = AttributeToModify->ValueLimits.MaxBaseValue;
+			return Attribute.ValueLimits.MaxBaseValue;
+		case EAttributeValueType::CurrentValue:
+			return Attribute.CurrentValue;
+		case EAttributeValueType::MinCurrentValue:
+			return Attribute.ValueLimits.MinCurrentValue;
+		case EAttributeValueType::MaxCurrentValue:
+			return Attribute.ValueLimits.MaxCurrentValue;
+	}
+
+	return 0;
+}
+
+void USimpleAttributeModifier::SetFloatAttributeValueOfType(FFloatAttribute& Attribute, const EAttributeValueType ValueType, const float NewValue, float& Overflow)
+{
+	switch (ValueType)
+	{
+		case EAttributeValueType::BaseValue:
+			Attribute.BaseValue = USimpleGameplayAbilityComponent::ClampFloatAttributeValue(Attribute, EAttributeValueType::BaseValue, NewValue, Overflow);
 			break;
+		
 		case EAttributeValueType::CurrentValue:
-			CurrentAttributeValue = AttributeToModify->CurrentValue;
+			Attribute.CurrentValue = USimpleGameplayAbilityComponent::ClampFloatAttributeValue(Attribute, EAttributeValueType::CurrentValue, NewValue, Overflow);
 			break;
-		case EAttributeValueType::MinCurrentValue:
-			CurrentAttributeValue = AttributeToModify->ValueLimits.MinCurrentValue;
+		
+		case EAttributeValueType::MaxBaseValue:
+			Attribute.ValueLimits.MaxBaseValue = NewValue;
+			break;
+		
+		case EAttributeValueType::MinBaseValue:
+			Attribute.ValueLimits.MinBaseValue = NewValue;
 			break;
+		
 		case EAttributeValueType::MaxCurrentValue:
-			CurrentAttributeValue = AttributeToModify->ValueLimits.MaxCurrentValue;
+			Attribute.ValueLimits.MaxCurrentValue = NewValue;
+			break;
+		
+		case EAttributeValueType::MinCurrentValue:
+			Attribute.ValueLimits.MinCurrentValue = NewValue;
 			break;
 	}
-	
-	// Next, modify AttributeToModify based on the input value and the modifier's operation
-	float NewAttributeValue = 0;
-	FGameplayTag FloatChangedDomainTag = AttributeToModify->AttributeTag;
-	switch (FloatModifier.ModificationOperation)
+}
+
+bool USimpleAttributeModifier::ApplyFloatOperation(const EFloatAttributeModificationOperation Operation, const float CurrentValue, const float InputValue, float& NewValue)
+{
+	switch (Operation)
 	{
 		case EFloatAttributeModificationOperation::Add:
-			NewAttributeValue = CurrentAttributeValue + ModificationInputValue;
-			break;
+			NewValue = CurrentValue + InputValue;
+			return true;
 
 		case EFloatAttributeModificationOperation::Subtract:
-			NewAttributeValue = CurrentAttributeValue - ModificationInputValue;
-			break;
+			NewValue = CurrentValue - InputValue;
+			return true;
 					
 		case EFloatAttributeModificationOperation::Multiply:
-			NewAttributeValue = CurrentAttributeValue * ModificationInputValue;
-			break;
+			NewValue = CurrentValue * InputValue;
+			return true;
 
 		case EFloatAttributeModificationOperation::Divide:
-			if (FMath::IsNearlyZero(ModificationInputValue))
+			if (FMath::IsNearlyZero(InputValue))
 			{
-				SIMPLE_LOG(OwningAbilityComponent, TEXT("[USimpleAttributeModifier::ApplyFloatAttributeModifier]: Division by zero."));
 				return false;
 			}
-			NewAttributeValue = CurrentAttributeValue / ModificationInputValue;
-			break;
+			NewValue = CurrentValue / InputValue;
+			return true;
 
 		case EFloatAttributeModificationOperation::Power:
-			NewAttributeValue = FMath::Pow(CurrentAttributeValue, ModificationInputValue);
-			break;
+			NewValue = FMath::Pow(CurrentValue, InputValue);
+			return true;
 		
 		case EFloatAttributeModificationOperation::Override:
-			NewAttributeValue =  ModificationInputValue;
-			break;
+			NewValue = InputValue;
+			return true;
 		
 		case EFloatAttributeModificationOperation::Custom:
-			if (!UFunctionSelectors::ApplyFloatAttributeOperation(
-				this,
-				FloatModifier.FloatOperationFunction,
-				AttributeToModify->AttributeTag,
-				CurrentAttributeValue,
-				ModificationInputValue,
-				CurrentOverflow,
-				FloatChangedDomainTag,
-				NewAttributeValue,
-				CurrentOverflow))
+			return false;
+	}
+
+	return false;
+}
+
+bool USimpleAttributeModifier::RunFloatModifierProgram(const FSimpleFloatModifierProgram& Program, const EAttributeModifierSideEffectTrigger TriggerPhase, FSimpleAttributeTransaction& Transaction, float& CurrentOverflow)
+{
+	const uint32 PhaseBit = 1u << static_cast<uint32>(TriggerPhase);
+	const bool IsDurationModifier = ModifierType == EAttributeModifierType::Duration;
+
+	// Slots are resolved to the transaction's attribute copies the first time an instruction uses them
+	TArray<int32, TInlineAllocator<8>> SlotCopyIndices;
+	SlotCopyIndices.Init(INDEX_NONE, Program.AttributeSlots.Num());
+
+	for (const FSimpleFloatModifierInstruction& Instruction : Program.Instructions)
+	{
+		if (IsDurationModifier && (Instruction.PhaseMask & PhaseBit) == 0)
+		{
+			continue;
+		}
+
+		const FGameplayTag& AttributeTag = Program.AttributeSlots[Instruction.AttributeSlot];
+		bool WasApplied = false;
+
+		if (Instruction.UsesCustomFunction)
+		{
+			const USimpleAttributeModifier* ModifierDefaults = GetClass()->GetDefaultObject<USimpleAttributeModifier>();
+			WasApplied = ApplyFloatAttributeModifier(ModifierDefaults->FloatAttributeModifications[Instruction.ModificationIndex], Transaction, CurrentOverflow);
+
+			if (WasApplied)
 			{
-				SIMPLE_LOG(OwningAbilityComponent, FString::Printf(TEXT("[USimpleAttributeModifier::ApplyFloatAttributeModifier]: Custom operation function %s failed to activate."), *FloatModifier.CustomInputFunction.GetMemberName().ToString()));
-				return false;
+				Transaction.MarkFloatAttributeModified(AttributeTag);
 			}
+		}
+		else
+		{
+			int32& AttributeCopyIndex = SlotCopyIndices[Instruction.AttributeSlot];
 
-			break;
+			if (AttributeCopyIndex == INDEX_NONE)
+			{
+				AttributeCopyIndex = Transaction.FindOrAddFloatAttribute(AttributeTag);
+			}
+
+			WasApplied = ExecuteFloatModifierInstruction(Instruction, AttributeTag, AttributeCopyIndex, Transaction, CurrentOverflow);
+		}
+
+		if (!WasApplied && Instruction.CancelIfAttributeNotFound)
+		{
+			return false;
+		}
 	}
 
-	// Lastly, we set the new value to the attribute
-	switch (FloatModifier.ModifiedAttributeValueType)
+	return true;
+}
+
+bool USimpleAttributeModifier::ExecuteFloatModifierInstruction(const FSimpleFloatModifierInstruction& Instruction, const FGameplayTag& AttributeTag, const int32 AttributeCopyIndex, FSimpleAttributeTransaction& Transaction, float& CurrentOverflow)
+{
+	if (AttributeCopyIndex == INDEX_NONE)
 	{
-		case EAttributeValueType::BaseValue:
-			AttributeToModify->BaseValue = OwningAbilityComponent->ClampFloatAttributeValue(*AttributeToModify, EAttributeValueType::BaseValue, NewAttributeValue, CurrentOverflow);
-			break;
-		
-		case EAttributeValueType::CurrentValue:
-			AttributeToModify->CurrentValue = OwningAbilityComponent->ClampFloatAttributeValue(*AttributeToModify, EAttributeValueType::CurrentValue, NewAttributeValue, CurrentOverflow);
-			break;
-		
-		case EAttributeValueType::MaxBaseValue:
-			AttributeToModify->ValueLimits.MaxBaseValue = NewAttributeValue;
+		SIMPLE_LOG(OwningAbilityComponent, FString::Printf(TEXT("[USimpleAttributeModifier::ExecuteFloatModifierInstruction]: Attribute %s not found."), *AttributeTag.ToString()));
+		return false;
+	}
+
+	float ModificationInputValue = 0;
+	bool WasSourceAttributeFound = true;
+
+	switch (Instruction.ModificationInputValueSource)
+	{
+		case EAttributeModificationValueSource::Manual:
+			ModificationInputValue = Instruction.ManualInputValue;
 			break;
-		
-		case EAttributeValueType::MinBaseValue:
-			AttributeToModify->ValueLimits.MinBaseValue = NewAttributeValue;
+
+		case EAttributeModificationValueSource::FromOverflow:
+			ModificationInputValue = CurrentOverflow;
+
+			if (Instruction.ConsumeOverflow)
+			{
+				CurrentOverflow = 0;
+			}
+
 			break;
-		
-		case EAttributeValueType::MaxCurrentValue:
-			AttributeToModify->ValueLimits.MaxCurrentValue = NewAttributeValue;
+
+		case EAttributeModificationValueSource::FromInstigatorAttribute:
+			if (!InstigatorAbilityComponent)
+			{
+				UE_LOG(LogSimpleGAS, Warning, TEXT("USimpleAttributeModifier::ExecuteFloatModifierInstruction: Instigator ability component is nullptr."));
+				return false;
+			}
+
+			ModificationInputValue = InstigatorAbilityComponent->GetFloatAttributeValue(Instruction.SourceAttributeValueType, Instruction.SourceAttribute, WasSourceAttributeFound);
 			break;
-		
-		case EAttributeValueType::MinCurrentValue:
-			AttributeToModify->ValueLimits.MinCurrentValue = NewAttributeValue;
+
+		case EAttributeModificationValueSource::FromTargetAttribute:
+			if (!TargetAbilityComponent)
+			{
+				UE_LOG(LogSimpleGAS, Warning, TEXT("USimpleAttributeModifier::ExecuteFloatModifierInstruction: Target ability component is nullptr."));
+				return false;
+			}
+
+			ModificationInputValue = TargetAbilityComponent->GetFloatAttributeValue(Instruction.SourceAttributeValueType, Instruction.SourceAttribute, WasSourceAttributeFound);
 			break;
+
+		case EAttributeModificationValueSource::CustomInputValue:
+			// Compiled with UsesCustomFunction and run through ApplyFloatAttributeModifier instead
+			return false;
 	}
-	
+
+	if (!WasSourceAttributeFound)
+	{
+		UE_LOG(LogSimpleGAS, Warning, TEXT("USimpleAttributeModifier::ExecuteFloatModifierInstruction: Source attribute %s not found."), *Instruction.SourceAttribute.ToString());
+		return false;
+	}
+
+	FFloatAttribute& AttributeToModify = Transaction.GetFloatAttributeAt(AttributeCopyIndex);
+	float NewAttributeValue = 0;
+
+	if (!ApplyFloatOperation(Instruction.ModificationOperation, GetFloatAttributeValueOfType(AttributeToModify, Instruction.ModifiedAttributeValueType), ModificationInputValue, NewAttributeValue))
+	{
+		SIMPLE_LOG(OwningAbilityComponent, TEXT("[USimpleAttributeModifier::ExecuteFloatModifierInstruction]: Division by zero."));
+		return false;
+	}
+
+	SetFloatAttributeValueOfType(AttributeToModify, Instruction.ModifiedAttributeValueType, NewAttributeValue, CurrentOverflow);
+	Transaction.MarkFloatAttributeModifiedAt(AttributeCopyIndex);
 	return true;
 }
 
-bool USimpleAttributeModifier::ApplyStructAttributeModifier(const FStructAttributeModifier& StructModifier, TArray<FStructAttribute>& TempStructAttributes)
+bool USimpleAttributeModifier::ApplyStructAttributeModifier(const FStructAttributeModifier& StructModifier, FSimpleAttributeTransaction& Transaction)
 {
-	FStructAttribute* AttributeToModify = GetTempStructAttribute(StructModifier.AttributeToModify, TempStructAttributes);
+	FStructAttribute* AttributeToModify = Transaction.GetStructAttribute(StructModifier.AttributeToModify);
 	
 	if (!AttributeToModify)
 	{
@@ -723,35 +1035,106 @@ void USimpleAttributeModifier::ApplySideEffects(USimpleGameplayAbilityComponent*
 	OwningAbilityComponent->AddAttributeStateSnapshot(AbilityInstanceID, Snapshot);
 }
 
-/* Utility Functions */
+/* Attribute Transaction */
+
+FFloatAttribute* FSimpleAttributeTransaction::GetFloatAttribute(const FGameplayTag& AttributeTag)
+{
+	const int32 Index = FindOrAddFloatAttribute(AttributeTag);
+	return Index != INDEX_NONE ? &FloatAttributes[Index].Attribute : nullptr;
+}
 
-FFloatAttribute* USimpleAttributeModifier::GetTempFloatAttribute(const FGameplayTag AttributeTag, TArray<FFloatAttribute>& TempFloatAttributes) const
+int32 FSimpleAttributeTransaction::FindOrAddFloatAttribute(const FGameplayTag& AttributeTag)
 {
-	for (int i = 0; i < TempFloatAttributes.Num(); i++)
+	// A modifier only touches a handful of attributes so a linear search of the copies is cheapest
+	for (int32 Index = 0; Index < FloatAttributes.Num(); Index++)
 	{
-		if (TempFloatAttributes[i].AttributeTag.MatchesTagExact(AttributeTag))
+		if (FloatAttributes[Index].Attribute.AttributeTag == AttributeTag)
 		{
-			return &TempFloatAttributes[i];
+			return Index;
 		}
 	}
 
-	return nullptr;
+	const FFloatAttribute* TargetAttribute = Target ? Target->GetAuthorityFloatAttribute(AttributeTag) : nullptr;
+
+	if (!TargetAttribute)
+	{
+		return INDEX_NONE;
+	}
+
+	return FloatAttributes.Add({ *TargetAttribute, false });
 }
 
-FStructAttribute* USimpleAttributeModifier::GetTempStructAttribute(const FGameplayTag AttributeTag, TArray<FStructAttribute>& TempStructAttributes) const
+FStructAttribute* FSimpleAttributeTransaction::GetStructAttribute(const FGameplayTag& AttributeTag)
 {
-	for (int i = 0; i < TempStructAttributes.Num(); i++)
+	for (TAttributeCopy<FStructAttribute>& Copy : StructAttributes)
 	{
-		if (TempStructAttributes[i].AttributeTag == AttributeTag)
+		if (Copy.Attribute.AttributeTag == AttributeTag)
 		{
-			return &TempStructAttributes[i];
+			return &Copy.Attribute;
 		}
 	}
 
-	return nullptr;
+	const FStructAttribute* TargetAttribute = Target ? Target->GetAuthorityStructAttribute(AttributeTag) : nullptr;
+
+	if (!TargetAttribute)
+	{
+		return nullptr;
+	}
+
+	return &StructAttributes.Add_GetRef({ *TargetAttribute, false }).Attribute;
+}
+
+void FSimpleAttributeTransaction::MarkFloatAttributeModified(const FGameplayTag& AttributeTag)
+{
+	for (TAttributeCopy<FFloatAttribute>& Copy : FloatAttributes)
+	{
+		if (Copy.Attribute.AttributeTag == AttributeTag)
+		{
+			Copy.bIsModified = true;
+			return;
+		}
+	}
+}
+
+void FSimpleAttributeTransaction::MarkStructAttributeModified(const FGameplayTag& AttributeTag)
+{
+	for (TAttributeCopy<FStructAttribute>& Copy : StructAttributes)
+	{
+		if (Copy.Attribute.AttributeTag == AttributeTag)
+		{
+			Copy.bIsModified = true;
+			return;
+		}
+	}
 }
 
-void USimpleAttributeModifier::OnTagsChanged(FGameplayTag EventTag, FGameplayTag Domain, FInstancedStruct Payload, UObject* Sender)
+void FSimpleAttributeTransaction::Commit() const
+{
+	if (!Target)
+	{
+		return;
+	}
+
+	for (const TAttributeCopy<FFloatAttribute>& Copy : FloatAttributes)
+	{
+		if (Copy.bIsModified)
+		{
+			Target->OverrideFloatAttribute(Copy.Attribute.AttributeTag, Copy.Attribute);
+		}
+	}
+
+	for (const TAttributeCopy<FStructAttribute>& Copy : StructAttributes)
+	{
+		if (Copy.bIsModified)
+		{
+			Target->SetStructAttributeValue(Copy.Attribute.AttributeTag, Copy.Attribute.AttributeValue);
+		}
+	}
+}
+
+/* Utility Functions */
+
+void USimpleAttributeModifier::OnTagsChanged(FGameplayTag EventTag, FGameplayTag Domain, const FInstancedStruct& Payload, UObject* Sender)
 {
 	if (ModifierType == EAttributeModifierType::Duration && bIsModifierActive)
 	{
@@ -765,15 +1148,71 @@ void USimpleAttributeModifier::OnTagsChanged(FGameplayTag EventTag, FGameplayTag
 				case EDurationTickTagRequirementBehaviour::SkipOnTagRequirementFailed:
 					return;
 				case EDurationTickTagRequirementBehaviour::PauseOnTagRequirementFailed:
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(DurationTimerHandle);
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(TickTimerHandle);
+					if (USimpleModifierScheduler* ModifierScheduler = GetModifierScheduler())
+					{
+						ModifierScheduler->PauseModifier(this);
+					}
 					return;
 			}
 		}
 		
-		InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(DurationTimerHandle);
-		InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(TickTimerHandle);
+		if (USimpleModifierScheduler* ModifierScheduler = GetModifierScheduler())
+		{
+			ModifierScheduler->UnpauseModifier(this);
+		}
+	}
+}
+
+void USimpleAttributeModifier::OnScheduledTick()
+{
+	if (!bIsModifierActive)
+	{
+		return;
+	}
+
+	USimpleModifierScheduler* ModifierScheduler = GetModifierScheduler();
+	
+	if (!CanApplyModifierInternal(InitialModifierContext))
+	{
+		switch (TickTagRequirementBehaviour)
+		{
+			case EDurationTickTagRequirementBehaviour::CancelOnTagRequirementFailed:
+				ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickCancel);
+				EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
+				return;
+			case EDurationTickTagRequirementBehaviour::SkipOnTagRequirementFailed:
+				UE_LOG(LogSimpleGAS, Warning, TEXT("[USimpleAttributeModifier::OnScheduledTick]: tag requirement failed on tick. Skipping modification."));
+				return;
+			case EDurationTickTagRequirementBehaviour::PauseOnTagRequirementFailed:
+				if (ModifierScheduler)
+				{
+					ModifierScheduler->PauseModifier(this);
+				}
+				return;
+		}
+	}
+
+	if (ModifierScheduler)
+	{
+		ModifierScheduler->UnpauseModifier(this);
 	}
+	
+	ApplyModifiersInternal(EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
+	ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
+}
+
+void USimpleAttributeModifier::OnScheduledDurationEnded()
+{
+	if (bIsModifierActive)
+	{
+		EndModifier(FDefaultTags::AbilityEndedSuccessfully(), FInstancedStruct());
+	}
+}
+
+USimpleModifierScheduler* USimpleAttributeModifier::GetModifierScheduler() const
+{
+	const UWorld* World = InstigatorAbilityComponent ? InstigatorAbilityComponent->GetWorld() : GetWorld();
+	return World ? World->GetSubsystem<USimpleModifierScheduler>() : nullptr;
 }
 
 void USimpleAttributeModifier::ClientFastForwardState(FGameplayTag StateTag, FSimpleAbilitySnapshot LatestAuthorityState)
@@ -6,6 +6,7 @@
 #include "SimpleAttributeModifier.generated.h"
 
 class USimpleGameplayAbility;
+class USimpleModifierScheduler;
 
 UCLASS(Blueprintable)
 class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleAttributeModifier : public USimpleAbilityBase
@@ -20,6 +21,13 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attribute Modifier|Config")
 	EAttributeModifierApplicationPolicy ModifierApplicationPolicy;
+
+	/**
+	 * If true, ApplyAttributeModifierToTarget applies this modifier from a compiled spec without creating a modifier
+	 * instance, attribute state or snapshot. Only used if the modifier qualifies, see GetInstantModifierSpec.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attribute Modifier|Config", meta = (EditCondition = "ModifierType == EAttributeModifierType::Instant"))
+	bool UseInstantModifierSpec = false;
 	
 	/**
 	 * Tags that can be used to classify this modifier. e.g. "DamageOverTime", "StatusEffect" etc.
@@ -63,14 +71,16 @@ public:
 
 	/**
 	 * These tags must be present on the target ability component for this modifier to apply.
+	 * Class defaults only, targets with UseGameplayTagBitSet check them from masks built once per class.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attribute Modifier|Requirements")
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attribute Modifier|Requirements")
 	FGameplayTagContainer TargetRequiredTags;
 
 	/**
 	 * These tags must NOT be present on the target ability component for this modifier to apply.
+	 * Class defaults only, targets with UseGameplayTagBitSet check them from masks built once per class.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attribute Modifier|Requirements")
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attribute Modifier|Requirements")
 	FGameplayTagContainer TargetBlockingTags;
 
 	/**
@@ -147,6 +157,7 @@ public:
 	void EndModifier(FGameplayTag EndingStatus, FInstancedStruct EndingContext);
 
 	virtual void CleanUpAbility_Implementation() override;
+	virtual void ResetAbility_Implementation() override;
 	
 	UFUNCTION(BlueprintCallable, Category = "Attribute Modifier|Lifecycle")
 	void AddModifierStack(int32 StackCount);
@@ -171,27 +182,78 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Attribute Modifier|Utility")
 	bool IsModifierActive() const { return bIsModifierActive; }
 
+	/**
+	 * Returns the compiled spec of an Instant modifier class or nullptr if the modifier needs an instance to apply, i.e. it
+	 * has struct modifications, side effects, tags to apply, remove or cancel, abilities to cancel, custom input or
+	 * operation functions, implements CanApplyModifier or a modifier event in Blueprint, or derives from a native class
+	 * that didn't set InstantModifierSpecNativeClass. Built once per class.
+	 */
+	static const FSimpleInstantModifierSpec* GetInstantModifierSpec(TSubclassOf<USimpleAttributeModifier> ModifierClass);
+
+	/**
+	 * Returns the FloatAttributeModifications of a modifier class compiled to an instruction array. Built once per class
+	 * from the class default object, so changes made to FloatAttributeModifications on a modifier instance are ignored
+	 * unless SimpleGAS.Modifiers.UseCompiledPrograms is 0.
+	 */
+	static const FSimpleFloatModifierProgram* GetFloatModifierProgram(TSubclassOf<USimpleAttributeModifier> ModifierClass);
+
+	/* Float modification steps shared by ApplyFloatAttributeModifier and instant modifier specs */
+	static float GetFloatAttributeValueOfType(const FFloatAttribute& Attribute, EAttributeValueType ValueType);
+	static void SetFloatAttributeValueOfType(FFloatAttribute& Attribute, EAttributeValueType ValueType, float NewValue, float& Overflow);
+	// Returns false for division by zero and Custom operations, which need a modifier instance
+	static bool ApplyFloatOperation(EFloatAttributeModificationOperation Operation, float CurrentValue, float InputValue, float& NewValue);
+
+	/* Called by USimpleModifierScheduler every TickInterval and once Duration has passed */
+	void OnScheduledTick();
+	void OnScheduledDurationEnded();
+
 	virtual void ClientFastForwardState(FGameplayTag StateTag, FSimpleAbilitySnapshot LatestAuthorityState) override;
 	virtual void ClientResolvePastState(FGameplayTag StateTag, FSimpleAbilitySnapshot AuthorityState, FSimpleAbilitySnapshot PredictedState) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Attribute Modifier|State")
 	USimpleGameplayAbilityComponent* InstigatorAbilityComponent;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Attribute Modifier|State")
 	USimpleGameplayAbilityComponent* TargetAbilityComponent;
 
-	UFUNCTION()
-	void OnTagsChanged(FGameplayTag EventTag, FGameplayTag Domain, FInstancedStruct Payload, UObject* Sender = nullptr);
+	void OnTagsChanged(FGameplayTag EventTag, FGameplayTag Domain, const FInstancedStruct& Payload, UObject* Sender);
 	
-	bool ApplyFloatAttributeModifier(const FFloatAttributeModifier& FloatModifier, TArray<FFloatAttribute>& TempFloatAttributes, float& CurrentOverflow);
-	bool ApplyStructAttributeModifier(const FStructAttributeModifier& StructModifier, TArray<FStructAttribute>& TempStructAttributes);
+	bool ApplyFloatAttributeModifier(const FFloatAttributeModifier& FloatModifier, FSimpleAttributeTransaction& Transaction, float& CurrentOverflow);
+	bool ApplyStructAttributeModifier(const FStructAttributeModifier& StructModifier, FSimpleAttributeTransaction& Transaction);
+	// Runs the compiled float modifier program of this class, returns false if a modification cancelled the modifier
+	bool RunFloatModifierProgram(const FSimpleFloatModifierProgram& Program, EAttributeModifierSideEffectTrigger TriggerPhase, FSimpleAttributeTransaction& Transaction, float& CurrentOverflow);
+	bool ExecuteFloatModifierInstruction(const FSimpleFloatModifierInstruction& Instruction, const FGameplayTag& AttributeTag, int32 AttributeCopyIndex, FSimpleAttributeTransaction& Transaction, float& CurrentOverflow);
 	bool ApplyModifiersInternal(const EAttributeModifierSideEffectTrigger TriggerPhase);
 
+	/**
+	 * C++ overrides of CanApplyModifier_Implementation or ApplyModifier aren't visible to reflection and would be skipped
+	 * by the instant modifier spec. A native subclass without such overrides sets this to its own class in its
+	 * constructor to let UseInstantModifierSpec apply to it and its Blueprint subclasses. Native subclasses of that
+	 * class have to set it again.
+	 */
+	const UClass* InstantModifierSpecNativeClass = nullptr;
+
 private:
 	bool bIsModifierActive = false;
 	FInstancedStruct InitialModifierContext;
-	FFloatAttribute* GetTempFloatAttribute(const FGameplayTag AttributeTag, TArray<FFloatAttribute>& TempFloatAttributes) const;
-	FStructAttribute* GetTempStructAttribute(const FGameplayTag AttributeTag, TArray<FStructAttribute>& TempStructAttributes) const;
-	
-	FTimerHandle DurationTimerHandle;
-	FTimerHandle TickTimerHandle;
+
+	// Returns the class default object with its target tag masks built, used when the target uses a tag bit set
+	const USimpleAttributeModifier* GetDefaultsWithTargetTagMasks() const;
+	mutable FGameplayTagBitMask TargetRequiredTagMask;
+	mutable FGameplayTagBitMask TargetBlockingTagMask;
+
+	// Built on the class default object by GetInstantModifierSpec, ModifierClass is null if the class doesn't qualify
+	void BuildInstantModifierSpec() const;
+	mutable bool bIsInstantModifierSpecBuilt = false;
+	mutable FSimpleInstantModifierSpec InstantModifierSpec;
+
+	// Built on the class default object by GetFloatModifierProgram
+	void BuildFloatModifierProgram() const;
+	mutable bool bIsFloatModifierProgramBuilt = false;
+	mutable FSimpleFloatModifierProgram FloatModifierProgram;
+
+	USimpleModifierScheduler* GetModifierScheduler() const;
 };
@@ -312,4 +312,108 @@ struct FAttributeModifierResult
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FAttributeModifierSideEffect> AppliedAttributeModifierSideEffects;
+};
+
+/* A FFloatAttributeModifier reduced to what an instant modifier spec needs to apply it */
+struct FSimpleInstantFloatModification
+{
+	FGameplayTag AttributeToModify;
+	EAttributeModiferNotFoundBehaviour IfAttributeNotFound = EAttributeModiferNotFoundBehaviour::CancelModifier;
+	EAttributeValueType ModifiedAttributeValueType = EAttributeValueType::BaseValue;
+	EAttributeModificationValueSource ModificationInputValueSource = EAttributeModificationValueSource::Manual;
+	float ManualInputValue = 0.0f;
+	FGameplayTag SourceAttribute;
+	EAttributeValueType SourceAttributeValueType = EAttributeValueType::BaseValue;
+	bool ConsumeOverflow = false;
+	EFloatAttributeModificationOperation ModificationOperation = EFloatAttributeModificationOperation::Add;
+};
+
+/**
+ * An immutable, compiled form of an Instant attribute modifier class that only modifies float attributes.
+ * Built once per class by USimpleAttributeModifier::GetInstantModifierSpec and applied with
+ * USimpleGameplayAbilityComponent::ApplyInstantModifierSpec, which doesn't create a modifier instance, attribute state or snapshot.
+ */
+struct FSimpleInstantModifierSpec
+{
+	TSubclassOf<USimpleAttributeModifier> ModifierClass;
+	EAttributeModifierApplicationPolicy ModifierApplicationPolicy = EAttributeModifierApplicationPolicy::ApplyServerOnly;
+	FGameplayTagContainer TargetRequiredTags;
+	FGameplayTagContainer TargetBlockingTags;
+	TArray<FSimpleInstantFloatModification> FloatModifications;
+};
+
+/* One FFloatAttributeModifier of a compiled float modifier program */
+struct FSimpleFloatModifierInstruction
+{
+	// Bit N is set if the modification applies in EAttributeModifierSideEffectTrigger N
+	uint32 PhaseMask = 0;
+	// Index of the modification in FloatAttributeModifications, used to run custom functions through the uncompiled path
+	int32 ModificationIndex = INDEX_NONE;
+	// Index of the attribute to modify in FSimpleFloatModifierProgram::AttributeSlots
+	int32 AttributeSlot = INDEX_NONE;
+	EAttributeValueType ModifiedAttributeValueType = EAttributeValueType::BaseValue;
+	EAttributeModificationValueSource ModificationInputValueSource = EAttributeModificationValueSource::Manual;
+	EFloatAttributeModificationOperation ModificationOperation = EFloatAttributeModificationOperation::Add;
+	EAttributeValueType SourceAttributeValueType = EAttributeValueType::BaseValue;
+	bool CancelIfAttributeNotFound = true;
+	bool ConsumeOverflow = false;
+	// Custom input values and operations call functions on the modifier, so they run through ApplyFloatAttributeModifier
+	bool UsesCustomFunction = false;
+	float ManualInputValue = 0.0f;
+	FGameplayTag SourceAttribute;
+};
+
+/**
+ * The FloatAttributeModifications of a modifier class compiled to a flat instruction array. Each attribute the
+ * modifications write to gets a slot that's resolved once per application no matter how many instructions use it.
+ * Built once per class by USimpleAttributeModifier::GetFloatModifierProgram.
+ */
+struct FSimpleFloatModifierProgram
+{
+	TArray<FGameplayTag> AttributeSlots;
+	TArray<FSimpleFloatModifierInstruction> Instructions;
+};
+
+/**
+ * Copies of the target's authority attributes that a modifier reads or writes while it applies, so that a modification
+ * that fails partway through changes nothing. An attribute is only copied the first time it's used, so applying a modifier
+ * costs the same no matter how many attributes the target has.
+ */
+struct SIMPLEGAMEPLAYABILITYSYSTEM_API FSimpleAttributeTransaction
+{
+	explicit FSimpleAttributeTransaction(USimpleGameplayAbilityComponent* InTarget) : Target(InTarget) {}
+
+	/**
+	 * Returns the transaction's copy of an attribute, copying it from the target the first time it's asked for.
+	 * The pointer is only valid until the next attribute is copied.
+	 * @return Null if the target doesn't have the attribute
+	 */
+	FFloatAttribute* GetFloatAttribute(const FGameplayTag& AttributeTag);
+	FStructAttribute* GetStructAttribute(const FGameplayTag& AttributeTag);
+
+	/**
+	 * Like GetFloatAttribute but returns the index of the copy, which stays valid for the lifetime of the transaction.
+	 * @return INDEX_NONE if the target doesn't have the attribute
+	 */
+	int32 FindOrAddFloatAttribute(const FGameplayTag& AttributeTag);
+	FFloatAttribute& GetFloatAttributeAt(const int32 Index) { return FloatAttributes[Index].Attribute; }
+
+	/* Only modified attributes are written back to the target on Commit */
+	void MarkFloatAttributeModified(const FGameplayTag& AttributeTag);
+	void MarkFloatAttributeModifiedAt(const int32 Index) { FloatAttributes[Index].bIsModified = true; }
+	void MarkStructAttributeModified(const FGameplayTag& AttributeTag);
+
+	void Commit() const;
+
+private:
+	template <typename AttributeType>
+	struct TAttributeCopy
+	{
+		AttributeType Attribute;
+		bool bIsModified = false;
+	};
+
+	USimpleGameplayAbilityComponent* Target = nullptr;
+	TArray<TAttributeCopy<FFloatAttribute>, TInlineAllocator<4>> FloatAttributes;
+	TArray<TAttributeCopy<FStructAttribute>, TInlineAllocator<2>> StructAttributes;
 };
\ No newline at end of file
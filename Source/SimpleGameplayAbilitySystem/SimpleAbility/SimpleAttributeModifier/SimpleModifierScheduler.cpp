@@ -0,0 +1,278 @@
+#include "SimpleModifierScheduler.h"
+
+#include "Engine/World.h"
+#include "SimpleAttributeModifier.h"
+#include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Process Scheduled Modifiers"), STAT_SimpleGAS_ProcessScheduledModifiers, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Modifiers Processed"), STAT_SimpleGAS_ScheduledModifiersProcessed, STATGROUP_SimpleGAS);
+
+namespace SimpleModifierScheduler
+{
+	struct FScheduleEntryLess
+	{
+		template <typename EntryType>
+		bool operator()(const EntryType& A, const EntryType& B) const
+		{
+			return A.DueTime < B.DueTime;
+		}
+	};
+}
+
+void USimpleModifierScheduler::ScheduleModifier(USimpleAttributeModifier* Modifier, const USimpleGameplayAbilityComponent* Target, const double Duration, const double TickInterval)
+{
+	if (!Modifier)
+	{
+		return;
+	}
+
+	const double CurrentTime = GetCurrentTime();
+
+	FScheduledModifier& Scheduled = ScheduledModifiers.FindOrAdd(TObjectKey<USimpleAttributeModifier>(Modifier));
+	InvalidateQueuedEntry(Scheduled);
+	
+	Scheduled.Modifier = Modifier;
+	Scheduled.Target = Target;
+	Scheduled.EndTime = Duration > 0 ? CurrentTime + Duration : -1;
+	Scheduled.TickInterval = TickInterval;
+	Scheduled.NextTickTime = TickInterval > 0 ? CurrentTime + TickInterval : -1;
+	Scheduled.bIsPaused = false;
+	Scheduled.Serial = NextSerial++;
+
+	QueueModifier(TObjectKey<USimpleAttributeModifier>(Modifier), Scheduled);
+	RemoveStaleEntries();
+}
+
+void USimpleModifierScheduler::UnscheduleModifier(const USimpleAttributeModifier* Modifier)
+{
+	const TObjectKey<USimpleAttributeModifier> ModifierKey(Modifier);
+
+	if (FScheduledModifier* Scheduled = ScheduledModifiers.Find(ModifierKey))
+	{
+		// Its heap entry is skipped when it comes up
+		InvalidateQueuedEntry(*Scheduled);
+		ScheduledModifiers.Remove(ModifierKey);
+		RemoveStaleEntries();
+	}
+}
+
+void USimpleModifierScheduler::PauseModifier(const USimpleAttributeModifier* Modifier)
+{
+	FScheduledModifier* Scheduled = ScheduledModifiers.Find(TObjectKey<USimpleAttributeModifier>(Modifier));
+
+	if (!Scheduled || Scheduled->bIsPaused)
+	{
+		return;
+	}
+
+	const double CurrentTime = GetCurrentTime();
+
+	Scheduled->EndTime = Scheduled->EndTime >= 0 ? FMath::Max(Scheduled->EndTime - CurrentTime, 0.0) : -1;
+	Scheduled->NextTickTime = Scheduled->NextTickTime >= 0 ? FMath::Max(Scheduled->NextTickTime - CurrentTime, 0.0) : -1;
+	Scheduled->bIsPaused = true;
+
+	InvalidateQueuedEntry(*Scheduled);
+	RemoveStaleEntries();
+}
+
+void USimpleModifierScheduler::UnpauseModifier(const USimpleAttributeModifier* Modifier)
+{
+	const TObjectKey<USimpleAttributeModifier> ModifierKey(Modifier);
+	FScheduledModifier* Scheduled = ScheduledModifiers.Find(ModifierKey);
+
+	if (!Scheduled || !Scheduled->bIsPaused)
+	{
+		return;
+	}
+
+	const double CurrentTime = GetCurrentTime();
+
+	Scheduled->EndTime = Scheduled->EndTime >= 0 ? CurrentTime + Scheduled->EndTime : -1;
+	Scheduled->NextTickTime = Scheduled->NextTickTime >= 0 ? CurrentTime + Scheduled->NextTickTime : -1;
+	Scheduled->bIsPaused = false;
+
+	QueueModifier(ModifierKey, *Scheduled);
+}
+
+bool USimpleModifierScheduler::IsModifierScheduled(const USimpleAttributeModifier* Modifier) const
+{
+	return ScheduledModifiers.Contains(TObjectKey<USimpleAttributeModifier>(Modifier));
+}
+
+void USimpleModifierScheduler::Deinitialize()
+{
+	ScheduledModifiers.Reset();
+	ScheduleHeap.Reset();
+	DueModifiers.Reset();
+	NumStaleEntries = 0;
+
+	Super::Deinitialize();
+}
+
+void USimpleModifierScheduler::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SimpleGAS_ProcessScheduledModifiers);
+
+	const double CurrentTime = GetCurrentTime();
+
+	// Take everything that's due off the heap first. Modifiers can apply, end and reschedule each other while we process them.
+	DueModifiers.Reset();
+
+	while (ScheduleHeap.Num() > 0 && ScheduleHeap.HeapTop().DueTime <= CurrentTime)
+	{
+		FScheduleEntry Entry;
+		ScheduleHeap.HeapPop(Entry, SimpleModifierScheduler::FScheduleEntryLess());
+
+		FScheduledModifier* Scheduled = ScheduledModifiers.Find(Entry.ModifierKey);
+
+		if (!Scheduled || Scheduled->Serial != Entry.Serial || Scheduled->QueuedTime != Entry.DueTime)
+		{
+			NumStaleEntries = FMath::Max(NumStaleEntries - 1, 0);
+			continue;
+		}
+
+		Scheduled->QueuedTime = -1;
+		DueModifiers.Add({ Entry.ModifierKey, Entry.Serial, Scheduled->Target.Get() });
+	}
+
+	// Process modifiers on the same target together so its attributes stay in cache
+	DueModifiers.StableSort([](const FDueModifier& A, const FDueModifier& B)
+	{
+		return A.Target < B.Target;
+	});
+
+	for (const FDueModifier& DueModifier : DueModifiers)
+	{
+		ProcessDueModifier(DueModifier, CurrentTime);
+	}
+
+	INC_DWORD_STAT_BY(STAT_SimpleGAS_ScheduledModifiersProcessed, DueModifiers.Num());
+	DueModifiers.Reset();
+}
+
+bool USimpleModifierScheduler::IsTickable() const
+{
+	return ScheduleHeap.Num() > 0;
+}
+
+TStatId USimpleModifierScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleModifierScheduler, STATGROUP_Tickables);
+}
+
+ETickableTickType USimpleModifierScheduler::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* USimpleModifierScheduler::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void USimpleModifierScheduler::ProcessDueModifier(const FDueModifier& DueModifier, const double CurrentTime)
+{
+	while (true)
+	{
+		// Looked up again every time because the callbacks can add and remove scheduled modifiers
+		FScheduledModifier* Scheduled = ScheduledModifiers.Find(DueModifier.ModifierKey);
+
+		// Stop if the modifier ended, was rescheduled or was paused by its own tick
+		if (!Scheduled || Scheduled->Serial != DueModifier.Serial || Scheduled->bIsPaused)
+		{
+			return;
+		}
+
+		USimpleAttributeModifier* Modifier = Scheduled->Modifier.Get();
+
+		if (!Modifier)
+		{
+			ScheduledModifiers.Remove(DueModifier.ModifierKey);
+			return;
+		}
+
+		const bool HasEndTime = Scheduled->EndTime >= 0;
+		// The tolerance keeps the last tick when the summed tick intervals land a hair after the end time
+		const bool IsTickDue = Scheduled->NextTickTime >= 0 && Scheduled->NextTickTime <= CurrentTime + UE_KINDA_SMALL_NUMBER &&
+			(!HasEndTime || Scheduled->NextTickTime <= Scheduled->EndTime + UE_KINDA_SMALL_NUMBER);
+
+		if (IsTickDue)
+		{
+			// Scheduled from the due time rather than now so ticks don't drift with the frame rate
+			Scheduled->NextTickTime += Scheduled->TickInterval;
+			Modifier->OnScheduledTick();
+			continue;
+		}
+
+		if (HasEndTime && Scheduled->EndTime <= CurrentTime)
+		{
+			ScheduledModifiers.Remove(DueModifier.ModifierKey);
+			Modifier->OnScheduledDurationEnded();
+			return;
+		}
+
+		QueueModifier(DueModifier.ModifierKey, *Scheduled);
+		return;
+	}
+}
+
+void USimpleModifierScheduler::QueueModifier(const TObjectKey<USimpleAttributeModifier>& ModifierKey, FScheduledModifier& Scheduled)
+{
+	const double DueTime = GetNextDueTime(Scheduled);
+
+	if (DueTime < 0)
+	{
+		Scheduled.QueuedTime = -1;
+		return;
+	}
+
+	Scheduled.QueuedTime = DueTime;
+	ScheduleHeap.HeapPush({ DueTime, ModifierKey, Scheduled.Serial }, SimpleModifierScheduler::FScheduleEntryLess());
+}
+
+void USimpleModifierScheduler::InvalidateQueuedEntry(FScheduledModifier& Scheduled)
+{
+	if (Scheduled.QueuedTime >= 0)
+	{
+		Scheduled.QueuedTime = -1;
+		NumStaleEntries++;
+	}
+}
+
+void USimpleModifierScheduler::RemoveStaleEntries()
+{
+	// Modifiers that are applied and removed faster than they come due would otherwise grow the heap without bound
+	if (NumStaleEntries <= ScheduleHeap.Num() - NumStaleEntries)
+	{
+		return;
+	}
+
+	ScheduleHeap.Reset();
+
+	for (const TPair<TObjectKey<USimpleAttributeModifier>, FScheduledModifier>& ScheduledPair : ScheduledModifiers)
+	{
+		if (ScheduledPair.Value.QueuedTime >= 0)
+		{
+			ScheduleHeap.Add({ ScheduledPair.Value.QueuedTime, ScheduledPair.Key, ScheduledPair.Value.Serial });
+		}
+	}
+
+	ScheduleHeap.Heapify(SimpleModifierScheduler::FScheduleEntryLess());
+	NumStaleEntries = 0;
+}
+
+double USimpleModifierScheduler::GetNextDueTime(const FScheduledModifier& Scheduled)
+{
+	if (Scheduled.NextTickTime >= 0 && Scheduled.EndTime >= 0)
+	{
+		return FMath::Min(Scheduled.NextTickTime, Scheduled.EndTime);
+	}
+
+	return Scheduled.NextTickTime >= 0 ? Scheduled.NextTickTime : Scheduled.EndTime;
+}
+
+double USimpleModifierScheduler::GetCurrentTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "SimpleModifierScheduler.generated.h"
+
+class USimpleAttributeModifier;
+class USimpleGameplayAbilityComponent;
+
+/**
+ * Runs the duration and tick timers of all active Duration attribute modifiers in a world from one min-heap instead of
+ * two FTimerManager timers per modifier. Everything due in a frame is processed in one pass, grouped by target component.
+ * Ticks are scheduled from the previous tick's due time, so they don't drift and several can run in one long frame.
+ * Ticks due at the same time as the modifier's end run before it ends.
+ */
+UCLASS()
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleModifierScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Starts the timers of a modifier, replacing any it already has.
+	 * @param Target The modifier's target, used to group the modifiers processed each frame
+	 * @param Duration Seconds until the modifier ends. 0 or less never ends it
+	 * @param TickInterval Seconds between ticks. 0 or less never ticks it
+	 */
+	void ScheduleModifier(USimpleAttributeModifier* Modifier, const USimpleGameplayAbilityComponent* Target, double Duration, double TickInterval);
+	void UnscheduleModifier(const USimpleAttributeModifier* Modifier);
+
+	/* Pausing freezes the time left until the modifier's next tick and its end, like FTimerManager::PauseTimer */
+	void PauseModifier(const USimpleAttributeModifier* Modifier);
+	void UnpauseModifier(const USimpleAttributeModifier* Modifier);
+
+	bool IsModifierScheduled(const USimpleAttributeModifier* Modifier) const;
+	int32 GetNumScheduledModifiers() const { return ScheduledModifiers.Num(); }
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject overrides
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+private:
+	struct FScheduledModifier
+	{
+		TWeakObjectPtr<USimpleAttributeModifier> Modifier;
+		TWeakObjectPtr<const USimpleGameplayAbilityComponent> Target;
+		// Both are world times, negative if the modifier never ends or never ticks
+		double EndTime = -1;
+		double NextTickTime = -1;
+		double TickInterval = 0;
+		// While paused EndTime and NextTickTime hold the time that was left instead
+		bool bIsPaused = false;
+		// Identifies this scheduling of the modifier, a rescheduled modifier gets a new one
+		uint32 Serial = 0;
+		// The due time of this modifier's valid heap entry, negative if it has none
+		double QueuedTime = -1;
+	};
+
+	struct FScheduleEntry
+	{
+		double DueTime = 0;
+		TObjectKey<USimpleAttributeModifier> ModifierKey;
+		uint32 Serial = 0;
+	};
+
+	struct FDueModifier
+	{
+		TObjectKey<USimpleAttributeModifier> ModifierKey;
+		uint32 Serial = 0;
+		const USimpleGameplayAbilityComponent* Target = nullptr;
+	};
+
+	// Runs the ticks and end of a modifier that are due, then queues it for its next due time
+	void ProcessDueModifier(const FDueModifier& DueModifier, double CurrentTime);
+	void QueueModifier(const TObjectKey<USimpleAttributeModifier>& ModifierKey, FScheduledModifier& Scheduled);
+	// Marks the modifier's heap entry as stale and rebuilds the heap once stale entries outnumber valid ones
+	void InvalidateQueuedEntry(FScheduledModifier& Scheduled);
+	void RemoveStaleEntries();
+	static double GetNextDueTime(const FScheduledModifier& Scheduled);
+	double GetCurrentTime() const;
+
+	TMap<TObjectKey<USimpleAttributeModifier>, FScheduledModifier> ScheduledModifiers;
+	// Min-heap by due time. Entries of unscheduled, rescheduled or paused modifiers are skipped when they come up.
+	TArray<FScheduleEntry> ScheduleHeap;
+	int32 NumStaleEntries = 0;
+	TArray<FDueModifier> DueModifiers;
+	uint32 NextSerial = 1;
+};
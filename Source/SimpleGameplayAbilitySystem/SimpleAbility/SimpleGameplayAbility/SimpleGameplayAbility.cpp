@@ -25,7 +25,12 @@ bool USimpleGameplayAbility::CanCancel_Implementation()
 
 bool USimpleGameplayAbility::ActivateAbility(const FGuid AbilityID, FInstancedStruct ActivationContext)
 {
-	AbilityInstanceID = AbilityID;
+	if (AbilityInstanceID != AbilityID)
+	{
+		const FGuid OldInstanceID = AbilityInstanceID;
+		AbilityInstanceID = AbilityID;
+		OwningAbilityComponent->UpdateInstanceID(this, OldInstanceID);
+	}
 	
 	if (!MeetsActivationRequirements(ActivationContext))
 	{
@@ -180,6 +185,16 @@ void USimpleGameplayAbility::CleanUpAbility_Implementation()
 	Super::CleanUpAbility_Implementation();
 }
 
+void USimpleGameplayAbility::ResetAbility_Implementation()
+{
+	EndOnEndedSubAbilities.Empty();
+	EndOnCancelledSubAbilities.Empty();
+	CachedActivationContext.Reset();
+	bIsAbilityActive = false;
+
+	Super::ResetAbility_Implementation();
+}
+
 void USimpleGameplayAbility::OnGranted_Implementation(USimpleGameplayAbilityComponent* GrantedAbilityComponent)
 { }
 
@@ -209,11 +224,6 @@ void USimpleGameplayAbility::EndAbilityInternal(FGameplayTag Status, FInstancedS
 	}
 	
 	bIsAbilityActive = false;
-
-	if (InstancingPolicy == EAbilityInstancingPolicy::MultipleInstances)
-	{
-		OwningAbilityComponent->RemoveInstancedAbility(this);
-	}
 	
 	FSimpleAbilityEndedEvent EndEvent;
 	EndEvent.AbilityID = AbilityInstanceID;
@@ -222,6 +232,12 @@ void USimpleGameplayAbility::EndAbilityInternal(FGameplayTag Status, FInstancedS
 	EndEvent.WasCancelled = WasCancelled;
 	
 	OwningAbilityComponent->SendEvent(FDefaultTags::AbilityEnded(), Status, FInstancedStruct::Make(EndEvent), GetAvatarActor(), { }, ESimpleEventReplicationPolicy::NoReplication);
+
+	// Removed after the ended event so listeners can still find this instance. Pooled instances can be reused from here on.
+	if (InstancingPolicy == EAbilityInstancingPolicy::MultipleInstances)
+	{
+		OwningAbilityComponent->RemoveInstancedAbility(this);
+	}
 }
 
 AActor* USimpleGameplayAbility::GetAvatarActor() const
@@ -362,7 +378,10 @@ ETickableTickType USimpleGameplayAbility::GetTickableTickType() const
 
 bool USimpleGameplayAbility::MeetsActivationRequirements(FInstancedStruct& ActivationContext)
 {
-	if (ActivationBlockingTags.Num() > 0)
+	// The tag masks can only tell that a requirement failed, so the loops below still run to find the tag to log
+	const bool MeetsTagRequirements = OwningAbilityComponent->UseGameplayTagBitSet && MeetsActivationTagMasks();
+
+	if (!MeetsTagRequirements && ActivationBlockingTags.Num() > 0)
 	{
 		for (const FGameplayTag& BlockingTag : ActivationBlockingTags)
 		{
@@ -375,7 +394,7 @@ bool USimpleGameplayAbility::MeetsActivationRequirements(FInstancedStruct& Activ
 		}
 	}
 
-	if (ActivationRequiredTags.Num() > 0)
+	if (!MeetsTagRequirements && ActivationRequiredTags.Num() > 0)
 	{
 		for (const FGameplayTag& RequiredTag : ActivationRequiredTags)
 		{
@@ -440,6 +459,20 @@ bool USimpleGameplayAbility::MeetsActivationRequirements(FInstancedStruct& Activ
 	return true;
 }
 
+bool USimpleGameplayAbility::MeetsActivationTagMasks() const
+{
+	const USimpleGameplayAbility* AbilityDefaults = GetClass()->GetDefaultObject<USimpleGameplayAbility>();
+
+	if (!AbilityDefaults->ActivationRequiredTagMask.IsUpToDate())
+	{
+		AbilityDefaults->ActivationRequiredTagMask = FGameplayTagBitMask(AbilityDefaults->ActivationRequiredTags);
+		AbilityDefaults->ActivationBlockingTagMask = FGameplayTagBitMask(AbilityDefaults->ActivationBlockingTags);
+	}
+
+	return OwningAbilityComponent->HasAllGameplayTags(AbilityDefaults->ActivationRequiredTagMask) &&
+		!OwningAbilityComponent->HasAnyGameplayTags(AbilityDefaults->ActivationBlockingTagMask);
+}
+
 void USimpleGameplayAbility::OnEnd_Implementation(FGameplayTag EndingStatus, FInstancedStruct EndingContext, bool WasCancelled) { }
 
 void USimpleGameplayAbility::ClientResolvePastState(FGameplayTag StateTag, FSimpleAbilitySnapshot AuthorityState, FSimpleAbilitySnapshot PredictedState)
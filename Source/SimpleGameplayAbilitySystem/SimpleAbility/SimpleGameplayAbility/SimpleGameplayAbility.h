@@ -21,6 +21,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Activation")
 	EAbilityInstancingPolicy InstancingPolicy = EAbilityInstancingPolicy::SingleInstance;
 
+	/**
+	 * If true, instances of this ability are kept by the ability component after they end and reused for later
+	 * activations instead of creating a new instance every time. ResetAbility is called before an instance is reused,
+	 * override it to reset any variables your ability sets while it's active.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Activation", meta = (EditCondition = "InstancingPolicy == EAbilityInstancingPolicy::MultipleInstances"))
+	bool AllowInstancePooling = false;
+
 	/* These tags must be present on the owning ability component for this ability to activate. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Activation")
 	FGameplayTagContainer ActivationRequiredTags;
@@ -117,6 +125,7 @@ public:
 	void CancelAbility(FGameplayTag CancelStatus, FInstancedStruct CancelContext, bool ForceCancel = false);
 
 	virtual void CleanUpAbility_Implementation() override;
+	virtual void ResetAbility_Implementation() override;
 	
 	/* Override these functions in your ability blueprint */
 
@@ -220,6 +229,11 @@ private:
 	TArray<FGuid> EndOnCancelledSubAbilities;
 
 	bool MeetsActivationRequirements(FInstancedStruct& ActivationContext);
+	bool MeetsActivationTagMasks() const;
 	bool bIsAbilityActive = false;
+
+	// Built on the class default object from its activation tags when the owning component uses a tag bit set
+	mutable FGameplayTagBitMask ActivationRequiredTagMask;
+	mutable FGameplayTagBitMask ActivationBlockingTagMask;
 	FInstancedStruct CachedActivationContext;
 };
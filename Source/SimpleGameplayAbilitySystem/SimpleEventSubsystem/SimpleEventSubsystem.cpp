@@ -1,27 +1,264 @@
 #include "SimpleEventSubSystem.h"
 #include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+#include "Misc/CoreDelegates.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/UObjectGlobals.h"
 
-void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload, UObject* Sender, TArray<UObject*> ListenerFilter)
+// Removed subscriptions are normally compacted once per frame in Tick. If this many pile up before that (or nothing
+// is ticking the subsystem) we compact them as soon as no DispatchEvent is running.
+static constexpr int32 MaxPendingRemovalsBeforeCompaction = 1024;
+
+DECLARE_CYCLE_STAT(TEXT("Deliver Event"), STAT_SimpleGAS_DeliverEvent, STATGROUP_SimpleGAS);
+DECLARE_CYCLE_STAT(TEXT("Flush Queued Events"), STAT_SimpleGAS_FlushQueuedEvents, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Events Delivered"), STAT_SimpleGAS_EventsDelivered, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Events Queued"), STAT_SimpleGAS_EventsQueued, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Event Listeners Called"), STAT_SimpleGAS_EventListenersCalled, STATGROUP_SimpleGAS);
+
+static int32 GSimpleEventStatsLevel = 0;
+static FAutoConsoleVariableRef CVarSimpleEventStatsLevel(
+	TEXT("SimpleGAS.Events.Stats"),
+	GSimpleEventStatsLevel,
+	TEXT("Records the cumulative cost of events for SimpleGAS.Events.DumpStats.\n")
+	TEXT("0: Off (default)\n")
+	TEXT("1: Record the count and time of every event tag, and the count of every event tag in CSV profiles\n")
+	TEXT("2: Also record the count and time of every listener"));
+
+static USimpleEventSubsystem* GetEventSubsystemForConsoleCommand(UWorld* World, FOutputDevice& Ar)
 {
-	// If we come across an invalid listener on a subscription (e.g. the listener was garbage collected and forgot to unsubscribe)
-	// we'll remove that subscription. We store the indexes of the invalid listeners here.
-	TArray<FEventSubscription> InvalidSubscriptions = TArray<FEventSubscription>();
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	USimpleEventSubsystem* EventSubsystem = GameInstance ? GameInstance->GetSubsystem<USimpleEventSubsystem>() : nullptr;
+
+	if (!EventSubsystem)
+	{
+		Ar.Log(TEXT("No SimpleEventSubsystem found for the current world."));
+	}
+
+	return EventSubsystem;
+}
 
-	// We check subscriptions from the most recently added to the oldest
-	for (int32 i = EventSubscriptions.Num() - 1; i >= 0; --i)
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpEventStatsCommand(
+	TEXT("SimpleGAS.Events.DumpStats"),
+	TEXT("Lists the event tags and listeners with the highest cumulative dispatch time. Needs SimpleGAS.Events.Stats to be enabled.\n")
+	TEXT("Usage: SimpleGAS.Events.DumpStats [NumToDump=10]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
 	{
-		if (!EventSubscriptions.IsValidIndex(i))
+		if (const USimpleEventSubsystem* EventSubsystem = GetEventSubsystemForConsoleCommand(World, Ar))
+		{
+			EventSubsystem->DumpEventStats(Ar, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ResetEventStatsCommand(
+	TEXT("SimpleGAS.Events.ResetStats"),
+	TEXT("Clears the event stats listed by SimpleGAS.Events.DumpStats."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (USimpleEventSubsystem* EventSubsystem = GetEventSubsystemForConsoleCommand(World, Ar))
+		{
+			EventSubsystem->ResetEventStats();
+		}
+	}));
+
+/* Groups a listener's stats with the other listeners of the same class and callback. */
+static FName MakeListenerStatName(const FEventSubscription& Subscription, const UObject* Listener)
+{
+	if (Subscription.CallbackDelegate.IsBound())
+	{
+		return FName(FString::Printf(TEXT("%s::%s"), *Listener->GetClass()->GetName(), *Subscription.CallbackDelegate.GetFunctionName().ToString()));
+	}
+
+	const TCHAR* DelegateType = Subscription.StructViewCallbackDelegate.IsBound() ? TEXT("typed")
+		: Subscription.ConsumingCallbackDelegate.IsBound() ? TEXT("consuming")
+		: TEXT("native");
+
+	return FName(FString::Printf(TEXT("%s (%s)"), *Listener->GetClass()->GetName(), DelegateType));
+}
+
+void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender, const TArray<UObject*>& ListenerFilter)
+{
+	DispatchEvent(EventTag, DomainTag, Payload, Sender, ListenerFilter);
+}
+
+void USimpleEventSubsystem::DispatchEvent(FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender,
+                                          TConstArrayView<UObject*> ListenerFilter, const UWorld* World)
+{
+	DispatchEventInternal(EventTag, DomainTag, FConstStructView(Payload), &Payload, Sender, ListenerFilter, World);
+}
+
+void USimpleEventSubsystem::DispatchEventInternal(FGameplayTag EventTag, FGameplayTag DomainTag, FConstStructView Payload, const FInstancedStruct* InstancedPayload,
+                                                  UObject* Sender, TConstArrayView<UObject*> ListenerFilter, const UWorld* World)
+{
+	if (!World && Sender)
+	{
+		World = GetSenderWorld(Sender);
+	}
+
+	if (ListenerFilter.IsEmpty() && !CoalescableEventTags.IsEmpty() && EventTag.MatchesAny(CoalescableEventTags))
+	{
+		QueueEvent(EventTag, DomainTag, Payload, Sender, World);
+		return;
+	}
+
+	DeliverEvent(EventTag, DomainTag, Payload, InstancedPayload, Sender, ListenerFilter, World);
+}
+
+const UWorld* USimpleEventSubsystem::GetSenderWorld(const UObject* Sender)
+{
+	const TObjectKey<UObject> SenderKey(Sender);
+
+	if (const TObjectKey<UWorld>* SenderWorld = SenderWorlds.Find(SenderKey))
+	{
+		return SenderWorld->ResolveObjectPtr();
+	}
+
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(Sender, EGetWorldErrorMode::ReturnNull) : nullptr;
+
+	// A sender without a world may still be added to one, so it's looked up again next time
+	if (World)
+	{
+		SenderWorlds.Add(SenderKey, World);
+	}
+
+	return World;
+}
+
+void USimpleEventSubsystem::DeliverEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FConstStructView Payload, const FInstancedStruct* InstancedPayload,
+                                         UObject* Sender, TConstArrayView<UObject*> ListenerFilter, const UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SimpleGAS_DeliverEvent);
+	CSV_SCOPED_TIMING_STAT(SimpleGAS, DeliverEvent);
+	INC_DWORD_STAT(STAT_SimpleGAS_EventsDelivered);
+	CSV_CUSTOM_STAT(SimpleGAS, EventsDelivered, 1, ECsvCustomStatOp::Accumulate);
+
+	// Read once so changing the cvar from a listener doesn't record half an event
+	const int32 StatsLevel = GSimpleEventStatsLevel;
+	const uint64 StartCycles = StatsLevel > 0 ? FPlatformTime::Cycles64() : 0;
+
+	if (!CandidateSubscriptionLists.IsValidIndex(DispatchDepth))
+	{
+		CandidateSubscriptionLists.Add(new TArray<FEventSubscriptionBucketEntry>());
+	}
+
+	TArray<FEventSubscriptionBucketEntry>& CandidateSubscriptions = CandidateSubscriptionLists[DispatchDepth];
+	CandidateSubscriptions.Reset();
+
+	// Gather the buckets whose sender and event filters can match this event. Each subscription is in at most
+	// one of these buckets for a given sender and event tag so we don't need to deduplicate them.
+	TArray<TConstArrayView<FEventSubscriptionBucketEntry>, TInlineAllocator<8>> MatchingBuckets;
+	auto GatherBucket = [&MatchingBuckets](const TArray<FEventSubscriptionBucketEntry>& Bucket)
+	{
+		MatchingBuckets.Add(Bucket);
+	};
+
+	auto GatherShard = [&EventTag, Sender, &GatherBucket](const FEventWorldShard& Shard)
+	{
+		Shard.SenderAgnosticSubscriptions.ForEachMatchingBucket(EventTag, GatherBucket);
+
+		if (Sender)
+		{
+			if (const FEventSubscriptionBuckets* SenderBuckets = Shard.SenderSubscriptions.Find(Sender))
+			{
+				SenderBuckets->ForEachMatchingBucket(EventTag, GatherBucket);
+			}
+		}
+	};
+
+	// Every subscription is in exactly one shard so gathering from several shards doesn't add duplicates either
+	if (World)
+	{
+		if (const FEventWorldShard* WorldShard = WorldShards.Find(TObjectKey<UWorld>(World)))
+		{
+			GatherShard(*WorldShard);
+		}
+
+		if (const FEventWorldShard* GlobalShard = WorldShards.Find(TObjectKey<UWorld>()))
+		{
+			GatherShard(*GlobalShard);
+		}
+	}
+	else
+	{
+		for (const TPair<TObjectKey<UWorld>, FEventWorldShard>& WorldShard : WorldShards)
+		{
+			GatherShard(WorldShard.Value);
+		}
+	}
+
+	// The buckets are already sorted (in reverse call order) so we merge them from the back instead of sorting the
+	// candidates. There are only a handful of buckets so picking the next entry is a linear scan.
+	TArray<int32, TInlineAllocator<8>> BucketCursors;
+	for (const TConstArrayView<FEventSubscriptionBucketEntry>& Bucket : MatchingBuckets)
+	{
+		BucketCursors.Add(Bucket.Num() - 1);
+	}
+
+	while (true)
+	{
+		int32 NextBucketIndex = INDEX_NONE;
+
+		for (int32 BucketIndex = 0; BucketIndex < MatchingBuckets.Num(); ++BucketIndex)
+		{
+			if (BucketCursors[BucketIndex] >= 0 &&
+				(NextBucketIndex == INDEX_NONE || MatchingBuckets[BucketIndex][BucketCursors[BucketIndex]].IsCalledBefore(
+					MatchingBuckets[NextBucketIndex][BucketCursors[NextBucketIndex]])))
+			{
+				NextBucketIndex = BucketIndex;
+			}
+		}
+
+		if (NextBucketIndex == INDEX_NONE)
+		{
+			break;
+		}
+
+		const FEventSubscriptionBucketEntry& NextEntry = MatchingBuckets[NextBucketIndex][BucketCursors[NextBucketIndex]--];
+		const FEventSubscription* Subscription = ResolveSubscription(NextEntry.Handle);
+
+		if (Subscription && !Subscription->IsPendingRemoval)
+		{
+			CandidateSubscriptions.Add(NextEntry);
+		}
+	}
+
+	// Typed payloads are only copied into an FInstancedStruct when the first listener that needs one is called
+	FInstancedStruct MaterializedPayload;
+	auto GetInstancedPayload = [&Payload, &InstancedPayload, &MaterializedPayload]() -> const FInstancedStruct&
+	{
+		if (!InstancedPayload)
+		{
+			MaterializedPayload.InitializeAs(Payload.GetScriptStruct(), Payload.GetMemory());
+			InstancedPayload = &MaterializedPayload;
+		}
+		return *InstancedPayload;
+	};
+
+	// Slots aren't freed while we're dispatching so the handles we gathered, and references to their subscriptions,
+	// stay valid even if listeners add or remove subscriptions
+	++DispatchDepth;
+
+	for (const FEventSubscriptionBucketEntry& CandidateSubscription : CandidateSubscriptions)
+	{
+		const FEventSubscriptionHandle SubscriptionHandle = CandidateSubscription.Handle;
+		FEventSubscription* SubscriptionPtr = ResolveSubscription(SubscriptionHandle);
+
+		// A listener called earlier in this loop may have removed this subscription
+		if (!SubscriptionPtr || SubscriptionPtr->IsPendingRemoval)
 		{
 			continue;
 		}
-		
-		FEventSubscription Subscription = EventSubscriptions[i];
+
+		FEventSubscription& Subscription = *SubscriptionPtr;
 
 		const UObject* Listener = Subscription.ListenerObject.Get();
-		
+
+		// If we come across an invalid listener on a subscription (e.g. the listener was garbage collected and forgot to unsubscribe)
+		// we'll remove that subscription.
 		if (!Listener)
 		{
-			InvalidSubscriptions.Add(Subscription);
+			RemoveSubscription(SubscriptionHandle);
 			continue;
 		}
 
@@ -30,24 +267,6 @@ void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag Domain
 			continue;
 		}
 
-		if (!Subscription.EventFilter.IsEmpty())
-		{
-			if (Subscription.OnlyMatchExactEvent)
-			{
-				if (!Subscription.EventFilter.HasTagExact(EventTag))
-				{
-					continue;
-				}
-			}
-			else
-			{
-				if (!Subscription.EventFilter.HasTag(EventTag))
-				{
-					continue;
-				}
-			}	
-		}
-
 		if (!Subscription.DomainFilter.IsEmpty())
 		{
 			if (Subscription.OnlyMatchExactDomain)
@@ -63,18 +282,18 @@ void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag Domain
 				{
 					continue;
 				}
-			}	
+			}
 		}
-		
+
 		if (Subscription.PayloadFilter.Num() > 0)
 		{
 			if (!Payload.IsValid())
 			{
 				UE_LOG(
 					LogSimpleGAS, Warning,
-					TEXT("No payload passed for Listener %s but the listener has a payload filter"), 
+					TEXT("No payload passed for Listener %s but the listener has a payload filter"),
 					*Listener->GetName());
-				continue;	
+				continue;
 			}
 
 			if (!Subscription.PayloadFilter.Contains(Payload.GetScriptStruct()))
@@ -87,20 +306,25 @@ void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag Domain
 			}
 		}
 
-		if (Subscription.SenderFilter.Num() > 0)
-		{
-			if (!Sender)
-			{
-				continue;
-			}
+		bool WasCalled = false;
+		bool WasConsumed = false;
+		const uint64 ListenerStartCycles = StatsLevel > 1 ? FPlatformTime::Cycles64() : 0;
 
-			if (!Subscription.SenderFilter.Contains(Sender))
-			{
-				continue;
-			}
+		if (Subscription.StructViewCallbackDelegate.IsBound())
+		{
+			WasCalled = Subscription.StructViewCallbackDelegate.ExecuteIfBound(EventTag, DomainTag, Payload, Sender);
+		}
+		else if (Subscription.ConsumingCallbackDelegate.IsBound())
+		{
+			WasConsumed = Subscription.ConsumingCallbackDelegate.Execute(EventTag, DomainTag, GetInstancedPayload(), Sender);
+			WasCalled = true;
+		}
+		else
+		{
+			WasCalled =
+				Subscription.NativeCallbackDelegate.ExecuteIfBound(EventTag, DomainTag, GetInstancedPayload(), Sender) ||
+				Subscription.CallbackDelegate.ExecuteIfBound(EventTag, DomainTag, GetInstancedPayload(), Sender);
 		}
-		
-		bool WasCalled = Subscription.CallbackDelegate.ExecuteIfBound(EventTag, DomainTag, Payload, Sender);
 
 		if (!WasCalled)
 		{
@@ -108,88 +332,789 @@ void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag Domain
 			continue;
 		}
 
+		INC_DWORD_STAT(STAT_SimpleGAS_EventListenersCalled);
+
+		if (StatsLevel > 1)
+		{
+			// Named on the first recorded call, most subscriptions are never timed
+			if (Subscription.StatName.IsNone())
+			{
+				Subscription.StatName = MakeListenerStatName(Subscription, Listener);
+			}
+
+			FEventDispatchStats& Stats = ListenerStats.FindOrAdd(Subscription.StatName);
+			++Stats.Count;
+			Stats.Cycles += FPlatformTime::Cycles64() - ListenerStartCycles;
+		}
+
 		if (Subscription.OnlyTriggerOnce)
 		{
-			InvalidSubscriptions.Add(Subscription);
+			RemoveSubscription(SubscriptionHandle);
+		}
+
+		if (WasConsumed)
+		{
+			break;
 		}
 	}
 
-	EventSubscriptions.RemoveAll([&InvalidSubscriptions](const FEventSubscription& Subscription) {
-		return InvalidSubscriptions.Contains(Subscription);
-	});
+	--DispatchDepth;
+
+	if (StatsLevel > 0)
+	{
+		FEventDispatchStats& Stats = EventTagStats.FindOrAdd(EventTag);
+		++Stats.Count;
+		Stats.Cycles += FPlatformTime::Cycles64() - StartCycles;
+
+#if CSV_PROFILER
+		FCsvProfiler::RecordCustomStat(EventTag.GetTagName(), CSV_CATEGORY_INDEX(SimpleGAS), 1, ECsvCustomStatOp::Accumulate);
+#endif
+	}
+
+	if (PendingRemovalSubscriptions.Num() >= MaxPendingRemovalsBeforeCompaction)
+	{
+		CompactSubscriptions();
+	}
 }
 
 FGuid USimpleEventSubsystem::ListenForEvent(UObject* Listener, bool OnlyTriggerOnce, FGameplayTagContainer EventFilter,
                                             FGameplayTagContainer DomainFilter, const FSimpleEventDelegate& EventReceivedDelegate,
                                             TArray<UScriptStruct*> PayloadFilter, TArray<UObject*> SenderFilter, bool OnlyMatchExactEvent,
-                                            bool OnlyMatchExactDomain)
+                                            bool OnlyMatchExactDomain, int32 Priority)
+{
+	FEventSubscription Subscription;
+	Subscription.CallbackDelegate = EventReceivedDelegate;
+
+	return ListenForEventInternal(MoveTemp(Subscription), Listener, OnlyTriggerOnce, EventFilter, DomainFilter,
+	                              PayloadFilter, SenderFilter, OnlyMatchExactEvent, OnlyMatchExactDomain, Priority);
+}
+
+FGuid USimpleEventSubsystem::ListenForEvent(UObject* Listener, bool OnlyTriggerOnce, const FGameplayTagContainer& EventFilter,
+                                            const FGameplayTagContainer& DomainFilter, const FSimpleNativeEventDelegate& EventReceivedDelegate,
+                                            TConstArrayView<UScriptStruct*> PayloadFilter, TConstArrayView<UObject*> SenderFilter,
+                                            bool OnlyMatchExactEvent, bool OnlyMatchExactDomain, int32 Priority)
+{
+	FEventSubscription Subscription;
+	Subscription.NativeCallbackDelegate = EventReceivedDelegate;
+
+	return ListenForEventInternal(MoveTemp(Subscription), Listener, OnlyTriggerOnce, EventFilter, DomainFilter,
+	                              PayloadFilter, SenderFilter, OnlyMatchExactEvent, OnlyMatchExactDomain, Priority);
+}
+
+FGuid USimpleEventSubsystem::ListenForEvent(UObject* Listener, bool OnlyTriggerOnce, const FGameplayTagContainer& EventFilter,
+                                            const FGameplayTagContainer& DomainFilter, const FSimpleConsumingEventDelegate& EventReceivedDelegate,
+                                            TConstArrayView<UScriptStruct*> PayloadFilter, TConstArrayView<UObject*> SenderFilter,
+                                            bool OnlyMatchExactEvent, bool OnlyMatchExactDomain, int32 Priority)
 {
 	FEventSubscription Subscription;
+	Subscription.ConsumingCallbackDelegate = EventReceivedDelegate;
+
+	return ListenForEventInternal(MoveTemp(Subscription), Listener, OnlyTriggerOnce, EventFilter, DomainFilter,
+	                              PayloadFilter, SenderFilter, OnlyMatchExactEvent, OnlyMatchExactDomain, Priority);
+}
 
+FGuid USimpleEventSubsystem::ListenForEventInternal(FEventSubscription&& Subscription, UObject* Listener, bool OnlyTriggerOnce,
+                                                    const FGameplayTagContainer& EventFilter, const FGameplayTagContainer& DomainFilter,
+                                                    TConstArrayView<UScriptStruct*> PayloadFilter, TConstArrayView<UObject*> SenderFilter,
+                                                    bool OnlyMatchExactEvent, bool OnlyMatchExactDomain, int32 Priority)
+{
 	if (!Listener)
 	{
 		UE_LOG(LogSimpleGAS, Warning, TEXT("Null Listener passed to ListenForEvent. Can't listen for event."));
-		return Subscription.EventSubscriptionID;
+		return FGuid();
 	}
 
-	if (!EventReceivedDelegate.IsBound())
+	if (!Subscription.CallbackDelegate.IsBound() && !Subscription.NativeCallbackDelegate.IsBound() &&
+		!Subscription.StructViewCallbackDelegate.IsBound() && !Subscription.ConsumingCallbackDelegate.IsBound())
 	{
 		UE_LOG(LogSimpleGAS, Warning, TEXT("No delegate bound to ListenForEvent. Can't listen for event."));
-		return Subscription.EventSubscriptionID;
+		return FGuid();
 	}
 
 	Subscription.EventSubscriptionID = FGuid::NewGuid();
 	Subscription.ListenerObject = Listener;
-	Subscription.CallbackDelegate = EventReceivedDelegate;
+	Subscription.ListenerWorld = TObjectKey<UWorld>(GEngine ? GEngine->GetWorldFromContextObject(Listener, EGetWorldErrorMode::ReturnNull) : nullptr);
 	Subscription.EventFilter.AppendTags(EventFilter);
 	Subscription.DomainFilter.AppendTags(DomainFilter);
-	Subscription.PayloadFilter = PayloadFilter;
+	Subscription.PayloadFilter.Append(PayloadFilter);
 	Subscription.SenderFilter.Append(SenderFilter);
 	Subscription.OnlyTriggerOnce = OnlyTriggerOnce;
 	Subscription.OnlyMatchExactEvent = OnlyMatchExactEvent;
 	Subscription.OnlyMatchExactDomain = OnlyMatchExactDomain;
+	Subscription.Priority = Priority;
+
+	const FGuid SubscriptionID = Subscription.EventSubscriptionID;
+	AddSubscription(MoveTemp(Subscription));
 
-	EventSubscriptions.Add(Subscription);
-	return Subscription.EventSubscriptionID;
+	return SubscriptionID;
 }
 
 void USimpleEventSubsystem::StopListeningForEventSubscriptionByID(FGuid EventSubscriptionID)
 {
-	EventSubscriptions.RemoveAll([this, EventSubscriptionID](const FEventSubscription& Subscription)
+	if (const FEventSubscriptionHandle* SubscriptionHandle = SubscriptionHandles.Find(EventSubscriptionID))
 	{
-		if (Subscription.EventSubscriptionID == EventSubscriptionID)
+		StopListeningForEventSubscription(*SubscriptionHandle);
+	}
+}
+
+void USimpleEventSubsystem::StopListeningForEventsByFilter(UObject* Listener, FGameplayTagContainer EventTagFilter, FGameplayTagContainer DomainTagFilter)
+{
+	const TArray<FEventSubscriptionHandle>* ListenerHandles = ListenerSubscriptions.Find(Listener);
+
+	if (!ListenerHandles)
+	{
+		return;
+	}
+
+	TArray<FGuid, TInlineAllocator<8>> RemovedSubscriptions;
+
+	for (const FEventSubscriptionHandle& SubscriptionHandle : *ListenerHandles)
+	{
+		const FEventSubscription* Subscription = ResolveSubscription(SubscriptionHandle);
+
+		if (Subscription && !Subscription->IsPendingRemoval &&
+			(!EventTagFilter.Num() || EventTagFilter.HasAny(Subscription->EventFilter)) &&
+			(!DomainTagFilter.Num() || DomainTagFilter.HasAny(Subscription->DomainFilter)))
 		{
-			OnEventSubscriptionRemoved.Broadcast(Subscription.EventSubscriptionID);
-			return true;
+			RemovedSubscriptions.Add(Subscription->EventSubscriptionID);
+			RemoveSubscription(SubscriptionHandle);
 		}
-		return false;
-	});
+	}
+
+	for (const FGuid& SubscriptionID : RemovedSubscriptions)
+	{
+		OnEventSubscriptionRemoved.Broadcast(SubscriptionID);
+	}
 }
 
-void USimpleEventSubsystem::StopListeningForEventsByFilter(UObject* Listener, FGameplayTagContainer EventTagFilter, FGameplayTagContainer DomainTagFilter)
+void USimpleEventSubsystem::StopListeningForAllEvents(UObject* Listener)
+{
+	const TArray<FEventSubscriptionHandle>* ListenerHandles = ListenerSubscriptions.Find(Listener);
+
+	if (!ListenerHandles)
+	{
+		return;
+	}
+
+	TArray<FGuid, TInlineAllocator<8>> RemovedSubscriptions;
+
+	for (const FEventSubscriptionHandle& SubscriptionHandle : *ListenerHandles)
+	{
+		const FEventSubscription* Subscription = ResolveSubscription(SubscriptionHandle);
+
+		if (Subscription && !Subscription->IsPendingRemoval)
+		{
+			RemovedSubscriptions.Add(Subscription->EventSubscriptionID);
+			RemoveSubscription(SubscriptionHandle);
+		}
+	}
+
+	for (const FGuid& SubscriptionID : RemovedSubscriptions)
+	{
+		OnEventSubscriptionRemoved.Broadcast(SubscriptionID);
+	}
+}
+
+void USimpleEventSubsystem::StopListeningForEventSubscription(FEventSubscriptionHandle SubscriptionHandle)
+{
+	const FEventSubscription* Subscription = ResolveSubscription(SubscriptionHandle);
+
+	if (!Subscription)
+	{
+		return;
+	}
+
+	const FGuid SubscriptionID = Subscription->EventSubscriptionID;
+
+	if (RemoveSubscription(SubscriptionHandle))
+	{
+		OnEventSubscriptionRemoved.Broadcast(SubscriptionID);
+	}
+}
+
+FEventSubscriptionHandle USimpleEventSubsystem::GetEventSubscriptionHandle(FGuid EventSubscriptionID) const
+{
+	if (const FEventSubscriptionHandle* SubscriptionHandle = SubscriptionHandles.Find(EventSubscriptionID))
+	{
+		return *SubscriptionHandle;
+	}
+
+	return FEventSubscriptionHandle();
+}
+
+void USimpleEventSubsystem::AddCoalescableEventTags(const FGameplayTagContainer& EventTags)
+{
+	CoalescableEventTags.AppendTags(EventTags);
+}
+
+void USimpleEventSubsystem::RemoveCoalescableEventTags(const FGameplayTagContainer& EventTags)
 {
-	EventSubscriptions.RemoveAll([this, Listener, EventTagFilter, DomainTagFilter](const FEventSubscription& Subscription)
+	CoalescableEventTags.RemoveTags(EventTags);
+}
+
+void USimpleEventSubsystem::SetEventFlushPoint(ESimpleEventFlushPoint NewFlushPoint)
+{
+	FlushPoint = NewFlushPoint;
+}
+
+void USimpleEventSubsystem::FlushQueuedEvents()
+{
+	// A listener flushing from inside a flush would overwrite the events we're delivering. Its events go out next flush.
+	if (IsFlushingQueuedEvents || QueuedEvents.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_SimpleGAS_FlushQueuedEvents);
+	CSV_SCOPED_TIMING_STAT(SimpleGAS, FlushQueuedEvents);
+
+	IsFlushingQueuedEvents = true;
+
+	// Events queued by listeners while we deliver go into the (now empty) QueuedEvents for the next flush
+	Swap(QueuedEvents, FlushingEvents);
+	QueuedEventIndices.Reset();
+
+	for (const FSimpleQueuedEvent& QueuedEvent : FlushingEvents)
 	{
-		if (Subscription.ListenerObject == Listener &&
-			(!EventTagFilter.Num() || EventTagFilter.HasAny(Subscription.EventFilter)) &&
-			(!DomainTagFilter.Num() || DomainTagFilter.HasAny(Subscription.DomainFilter)))
+		UObject* Sender = QueuedEvent.Sender.Get();
+		const UWorld* World = QueuedEvent.World.Get();
+
+		// Don't deliver events from senders or worlds that were destroyed while the event was queued
+		if ((QueuedEvent.HasSender && !Sender) || (QueuedEvent.HasWorld && !World))
+		{
+			continue;
+		}
+
+		DeliverEvent(QueuedEvent.EventTag, QueuedEvent.DomainTag, FConstStructView(QueuedEvent.Payload), &QueuedEvent.Payload, Sender, {}, World);
+	}
+
+	FlushingEvents.Reset();
+	IsFlushingQueuedEvents = false;
+}
+
+void USimpleEventSubsystem::QueueEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FConstStructView Payload, UObject* Sender, const UWorld* World)
+{
+	const TTuple<TObjectKey<UWorld>, TWeakObjectPtr<UObject>, FGameplayTag, FGameplayTag> QueueKey(TObjectKey<UWorld>(World), Sender, EventTag, DomainTag);
+
+	if (const int32* QueuedEventIndex = QueuedEventIndices.Find(QueueKey))
+	{
+		QueuedEvents[*QueuedEventIndex].Payload.InitializeAs(Payload.GetScriptStruct(), Payload.GetMemory());
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_SimpleGAS_EventsQueued);
+
+	FSimpleQueuedEvent& QueuedEvent = QueuedEvents.AddDefaulted_GetRef();
+	QueuedEvent.EventTag = EventTag;
+	QueuedEvent.DomainTag = DomainTag;
+	QueuedEvent.Payload.InitializeAs(Payload.GetScriptStruct(), Payload.GetMemory());
+	QueuedEvent.Sender = Sender;
+	QueuedEvent.HasSender = Sender != nullptr;
+	QueuedEvent.World = World;
+	QueuedEvent.HasWorld = World != nullptr;
+
+	QueuedEventIndices.Add(QueueKey, QueuedEvents.Num() - 1);
+}
+
+void USimpleEventSubsystem::DumpEventStats(FOutputDevice& Ar, int32 NumToDump) const
+{
+	if (EventTagStats.IsEmpty() && ListenerStats.IsEmpty())
+	{
+		Ar.Log(TEXT("No event stats recorded. Set SimpleGAS.Events.Stats to 1 (event tags) or 2 (event tags and listeners) to record them."));
+		return;
+	}
+
+	auto DumpTopStats = [&Ar, NumToDump](const TCHAR* Heading, const auto& StatsMap)
+	{
+		auto SortedStats = StatsMap.Array();
+		SortedStats.Sort([](const auto& A, const auto& B) { return A.Value.Cycles > B.Value.Cycles; });
+
+		Ar.Logf(TEXT("%s (%d recorded):"), Heading, SortedStats.Num());
+
+		for (int32 StatIndex = 0; StatIndex < FMath::Min(NumToDump, SortedStats.Num()); ++StatIndex)
+		{
+			const auto& Stat = SortedStats[StatIndex];
+			const double TotalMs = FPlatformTime::ToMilliseconds64(Stat.Value.Cycles);
+
+			Ar.Logf(TEXT("  %-60s %10llu calls %10.3f ms total %8.3f us avg"),
+				*Stat.Key.ToString(), Stat.Value.Count, TotalMs, Stat.Value.Count > 0 ? TotalMs * 1000.0 / Stat.Value.Count : 0.0);
+		}
+	};
+
+	DumpTopStats(TEXT("Event tags by cumulative time"), EventTagStats);
+	DumpTopStats(TEXT("Listeners by cumulative time"), ListenerStats);
+}
+
+void USimpleEventSubsystem::ResetEventStats()
+{
+	EventTagStats.Reset();
+	ListenerStats.Reset();
+}
+
+void USimpleEventSubsystem::OnEndFrame()
+{
+	if (FlushPoint == ESimpleEventFlushPoint::EndOfFrame)
+	{
+		FlushQueuedEvents();
+	}
+}
+
+void USimpleEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	EndFrameDelegateHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &USimpleEventSubsystem::OnEndFrame);
+	WorldCleanupDelegateHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &USimpleEventSubsystem::OnWorldCleanup);
+	PostGarbageCollectDelegateHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &USimpleEventSubsystem::OnPostGarbageCollect);
+}
+
+void USimpleEventSubsystem::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameDelegateHandle);
+	EndFrameDelegateHandle.Reset();
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupDelegateHandle);
+	WorldCleanupDelegateHandle.Reset();
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectDelegateHandle);
+	PostGarbageCollectDelegateHandle.Reset();
+
+	// Queued events are dropped. Their listeners are being torn down with the game instance.
+	QueuedEvents.Reset();
+	QueuedEventIndices.Reset();
+	SenderWorlds.Reset();
+
+	Super::Deinitialize();
+}
+
+void USimpleEventSubsystem::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	const TObjectKey<UWorld> WorldKey(World);
+
+	for (auto SenderWorldIt = SenderWorlds.CreateIterator(); SenderWorldIt; ++SenderWorldIt)
+	{
+		if (SenderWorldIt.Value() == WorldKey)
+		{
+			SenderWorldIt.RemoveCurrent();
+		}
+	}
+
+	if (!WorldShards.Contains(WorldKey))
+	{
+		return;
+	}
+
+	TArray<FGuid> RemovedSubscriptions;
+
+	for (int32 SlotIndex = 0; SlotIndex < SubscriptionSlots.Num(); ++SlotIndex)
+	{
+		const FEventSubscriptionSlot& Slot = SubscriptionSlots[SlotIndex];
+
+		if (Slot.IsOccupied && !Slot.Subscription->IsPendingRemoval && Slot.Subscription->ListenerWorld == WorldKey)
+		{
+			RemovedSubscriptions.Add(Slot.Subscription->EventSubscriptionID);
+			RemoveSubscription(FEventSubscriptionHandle{ SlotIndex, Slot.Generation });
+		}
+	}
+
+	for (const FGuid& SubscriptionID : RemovedSubscriptions)
+	{
+		OnEventSubscriptionRemoved.Broadcast(SubscriptionID);
+	}
+
+	// Compacting also removes the world's shard now that it's empty
+	CompactSubscriptions();
+}
+
+void USimpleEventSubsystem::OnPostGarbageCollect()
+{
+	HasGarbageCollectedSinceLastSweep = true;
+}
+
+void USimpleEventSubsystem::RemoveInvalidListenerSubscriptions()
+{
+	TArray<FGuid> RemovedSubscriptions;
+
+	for (const TPair<TWeakObjectPtr<UObject>, TArray<FEventSubscriptionHandle>>& ListenerHandles : ListenerSubscriptions)
+	{
+		if (ListenerHandles.Key.IsValid())
+		{
+			continue;
+		}
+
+		for (const FEventSubscriptionHandle& SubscriptionHandle : ListenerHandles.Value)
+		{
+			const FEventSubscription* Subscription = ResolveSubscription(SubscriptionHandle);
+
+			if (Subscription && !Subscription->IsPendingRemoval)
 			{
-				OnEventSubscriptionRemoved.Broadcast(Subscription.EventSubscriptionID);
-				return true;
+				RemovedSubscriptions.Add(Subscription->EventSubscriptionID);
+				RemoveSubscription(SubscriptionHandle);
 			}
-		return false;
-	});
+		}
+	}
+
+	for (const FGuid& SubscriptionID : RemovedSubscriptions)
+	{
+		OnEventSubscriptionRemoved.Broadcast(SubscriptionID);
+	}
 }
 
-void USimpleEventSubsystem::StopListeningForAllEvents(UObject* Listener)
+void USimpleEventSubsystem::Tick(float DeltaTime)
 {
-	EventSubscriptions.RemoveAll([this, Listener](const FEventSubscription& Subscription)
+	if (FlushPoint == ESimpleEventFlushPoint::SubsystemTick)
 	{
-		if (Subscription.ListenerObject == Listener)
+		FlushQueuedEvents();
+	}
+
+	if (HasGarbageCollectedSinceLastSweep)
+	{
+		HasGarbageCollectedSinceLastSweep = false;
+		RemoveInvalidListenerSubscriptions();
+
+		for (auto SenderWorldIt = SenderWorlds.CreateIterator(); SenderWorldIt; ++SenderWorldIt)
 		{
-			OnEventSubscriptionRemoved.Broadcast(Subscription.EventSubscriptionID);
-			return true;
+			if (!SenderWorldIt.Key().ResolveObjectPtr())
+			{
+				SenderWorldIt.RemoveCurrent();
+			}
 		}
+	}
+
+	CompactSubscriptions();
+}
+
+bool USimpleEventSubsystem::IsTickable() const
+{
+	return PendingRemovalSubscriptions.Num() > 0
+		|| HasGarbageCollectedSinceLastSweep
+		|| (FlushPoint == ESimpleEventFlushPoint::SubsystemTick && QueuedEvents.Num() > 0);
+}
+
+TStatId USimpleEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleEventSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType USimpleEventSubsystem::GetTickableTickType() const
+{
+	// The CDO never has subscriptions to compact
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+FEventSubscriptionHandle USimpleEventSubsystem::AddSubscription(FEventSubscription&& Subscription)
+{
+	if (PendingRemovalSubscriptions.Num() >= MaxPendingRemovalsBeforeCompaction)
+	{
+		CompactSubscriptions();
+	}
+
+	FEventSubscriptionHandle SubscriptionHandle;
+
+	if (FreeSubscriptionSlots.Num() > 0)
+	{
+		SubscriptionHandle.SlotIndex = FreeSubscriptionSlots.Pop();
+	}
+	else
+	{
+		SubscriptionHandle.SlotIndex = SubscriptionSlots.AddDefaulted();
+	}
+
+	FEventSubscriptionSlot& Slot = SubscriptionSlots[SubscriptionHandle.SlotIndex];
+	SubscriptionHandle.Generation = Slot.Generation;
+
+	Subscription.SubscriptionOrder = NextSubscriptionOrder++;
+	Subscription.IsPendingRemoval = false;
+
+	if (Slot.Subscription.IsValid())
+	{
+		*Slot.Subscription = MoveTemp(Subscription);
+	}
+	else
+	{
+		Slot.Subscription = MakeUnique<FEventSubscription>(MoveTemp(Subscription));
+	}
+	Slot.IsOccupied = true;
+
+	const FEventSubscription& AddedSubscription = *Slot.Subscription;
+	SubscriptionHandles.Add(AddedSubscription.EventSubscriptionID, SubscriptionHandle);
+	ListenerSubscriptions.FindOrAdd(AddedSubscription.ListenerObject).Add(SubscriptionHandle);
+	AddSubscriptionToDispatchTable(SubscriptionHandle, AddedSubscription);
+
+	return SubscriptionHandle;
+}
+
+FEventSubscription* USimpleEventSubsystem::ResolveSubscription(FEventSubscriptionHandle SubscriptionHandle) const
+{
+	if (!SubscriptionSlots.IsValidIndex(SubscriptionHandle.SlotIndex))
+	{
+		return nullptr;
+	}
+
+	const FEventSubscriptionSlot& Slot = SubscriptionSlots[SubscriptionHandle.SlotIndex];
+
+	if (!Slot.IsOccupied || Slot.Generation != SubscriptionHandle.Generation)
+	{
+		return nullptr;
+	}
+
+	return Slot.Subscription.Get();
+}
+
+bool USimpleEventSubsystem::RemoveSubscription(FEventSubscriptionHandle SubscriptionHandle)
+{
+	FEventSubscription* Subscription = ResolveSubscription(SubscriptionHandle);
+
+	if (!Subscription || Subscription->IsPendingRemoval)
+	{
 		return false;
-	});
+	}
+
+	Subscription->IsPendingRemoval = true;
+	SubscriptionHandles.Remove(Subscription->EventSubscriptionID);
+	PendingRemovalSubscriptions.Add(SubscriptionHandle);
+
+	return true;
+}
+
+void USimpleEventSubsystem::CompactSubscriptions()
+{
+	if (DispatchDepth > 0 || PendingRemovalSubscriptions.IsEmpty())
+	{
+		return;
+	}
+
+	TSet<TWeakObjectPtr<UObject>> DirtyListeners;
+
+	for (const FEventSubscriptionHandle& SubscriptionHandle : PendingRemovalSubscriptions)
+	{
+		if (const FEventSubscription* Subscription = ResolveSubscription(SubscriptionHandle))
+		{
+			MarkSubscriptionRemovedFromDispatchTable(*Subscription);
+			DirtyListeners.Add(Subscription->ListenerObject);
+		}
+	}
+
+	auto IsRemoved = [this](FEventSubscriptionHandle SubscriptionHandle)
+	{
+		const FEventSubscription* Subscription = ResolveSubscription(SubscriptionHandle);
+		return !Subscription || Subscription->IsPendingRemoval;
+	};
+
+	// Each dirty bucket is compacted once no matter how many of its subscriptions were removed
+	for (const TObjectKey<UWorld>& World : DirtyWorldShards)
+	{
+		FEventWorldShard* WorldShard = WorldShards.Find(World);
+
+		if (!WorldShard)
+		{
+			continue;
+		}
+
+		if (WorldShard->AreSenderAgnosticSubscriptionsDirty)
+		{
+			WorldShard->SenderAgnosticSubscriptions.Compact(IsRemoved);
+			WorldShard->AreSenderAgnosticSubscriptionsDirty = false;
+		}
+
+		for (const TWeakObjectPtr<UObject>& Sender : WorldShard->DirtySenderSubscriptions)
+		{
+			if (FEventSubscriptionBuckets* SenderBuckets = WorldShard->SenderSubscriptions.Find(Sender))
+			{
+				SenderBuckets->Compact(IsRemoved);
+
+				if (SenderBuckets->IsEmpty())
+				{
+					WorldShard->SenderSubscriptions.Remove(Sender);
+				}
+			}
+		}
+		WorldShard->DirtySenderSubscriptions.Reset();
+
+		if (WorldShard->IsEmpty())
+		{
+			WorldShards.Remove(World);
+		}
+	}
+	DirtyWorldShards.Reset();
+
+	for (const TWeakObjectPtr<UObject>& Listener : DirtyListeners)
+	{
+		if (TArray<FEventSubscriptionHandle>* ListenerHandles = ListenerSubscriptions.Find(Listener))
+		{
+			ListenerHandles->RemoveAll(IsRemoved);
+
+			if (ListenerHandles->IsEmpty())
+			{
+				ListenerSubscriptions.Remove(Listener);
+			}
+		}
+	}
+
+	// Now nothing references the removed subscriptions we can free their slots
+	for (const FEventSubscriptionHandle& SubscriptionHandle : PendingRemovalSubscriptions)
+	{
+		if (ResolveSubscription(SubscriptionHandle))
+		{
+			FEventSubscriptionSlot& Slot = SubscriptionSlots[SubscriptionHandle.SlotIndex];
+			*Slot.Subscription = FEventSubscription();
+			Slot.IsOccupied = false;
+			++Slot.Generation;
+			FreeSubscriptionSlots.Add(SubscriptionHandle.SlotIndex);
+		}
+	}
+	PendingRemovalSubscriptions.Reset();
+}
+
+void USimpleEventSubsystem::AddSubscriptionToDispatchTable(FEventSubscriptionHandle SubscriptionHandle, const FEventSubscription& Subscription)
+{
+	FEventWorldShard& WorldShard = WorldShards.FindOrAdd(Subscription.ListenerWorld);
+
+	if (Subscription.SenderFilter.IsEmpty())
+	{
+		WorldShard.SenderAgnosticSubscriptions.AddSubscription(SubscriptionHandle, Subscription);
+		return;
+	}
+
+	// Null senders can never match because DispatchEvent only checks sender buckets when a sender is passed in
+	TArray<TWeakObjectPtr<UObject>, TInlineAllocator<4>> Senders;
+	for (const TWeakObjectPtr<UObject>& Sender : Subscription.SenderFilter)
+	{
+		if (Sender.IsValid())
+		{
+			Senders.AddUnique(Sender);
+		}
+	}
+
+	for (const TWeakObjectPtr<UObject>& Sender : Senders)
+	{
+		WorldShard.SenderSubscriptions.FindOrAdd(Sender).AddSubscription(SubscriptionHandle, Subscription);
+	}
+}
+
+void USimpleEventSubsystem::MarkSubscriptionRemovedFromDispatchTable(const FEventSubscription& Subscription)
+{
+	FEventWorldShard* WorldShard = WorldShards.Find(Subscription.ListenerWorld);
+
+	if (!WorldShard)
+	{
+		return;
+	}
+
+	DirtyWorldShards.Add(Subscription.ListenerWorld);
+
+	if (Subscription.SenderFilter.IsEmpty())
+	{
+		WorldShard->SenderAgnosticSubscriptions.MarkSubscriptionRemoved(Subscription);
+		WorldShard->AreSenderAgnosticSubscriptionsDirty = true;
+		return;
+	}
+
+	// The sender may have been garbage collected since the subscription was added. TWeakObjectPtr hashes and compares
+	// by object index and serial number so stale senders still find their buckets.
+	for (const TWeakObjectPtr<UObject>& Sender : Subscription.SenderFilter)
+	{
+		if (FEventSubscriptionBuckets* SenderBuckets = WorldShard->SenderSubscriptions.Find(Sender))
+		{
+			SenderBuckets->MarkSubscriptionRemoved(Subscription);
+			WorldShard->DirtySenderSubscriptions.Add(Sender);
+		}
+	}
+}
+
+void FEventSubscriptionBuckets::AddSubscription(FEventSubscriptionHandle Handle, const FEventSubscription& Subscription)
+{
+	FEventSubscriptionBucketEntry Entry;
+	Entry.Handle = Handle;
+	Entry.Priority = Subscription.Priority;
+	Entry.SubscriptionOrder = Subscription.SubscriptionOrder;
+
+	// Buckets are sorted in reverse call order. New subscriptions are called before every other subscription with the
+	// same priority so when all priorities are equal this is just an Add at the end of the bucket.
+	auto InsertSorted = [&Entry](TArray<FEventSubscriptionBucketEntry>& Bucket)
+	{
+		const int32 InsertIndex = Algo::UpperBound(Bucket, Entry, [](const FEventSubscriptionBucketEntry& A, const FEventSubscriptionBucketEntry& B)
+		{
+			return B.IsCalledBefore(A);
+		});
+		Bucket.Insert(Entry, InsertIndex);
+	};
+
+	if (Subscription.EventFilter.IsEmpty())
+	{
+		InsertSorted(MatchAllEventBucket);
+		return;
+	}
+
+	if (Subscription.OnlyMatchExactEvent)
+	{
+		for (const FGameplayTag& EventTag : Subscription.EventFilter)
+		{
+			InsertSorted(ExactEventBuckets.FindOrAdd(EventTag));
+		}
+		return;
+	}
+
+	// FGameplayTagContainer::HasTag also matches the parents of the tags in the container so we register the
+	// subscription under every tag it can match. GetGameplayTagParents doesn't return duplicates.
+	for (const FGameplayTag& EventTag : Subscription.EventFilter.GetGameplayTagParents())
+	{
+		InsertSorted(ParentEventBuckets.FindOrAdd(EventTag));
+	}
+}
+
+void FEventSubscriptionBuckets::MarkSubscriptionRemoved(const FEventSubscription& Subscription)
+{
+	if (Subscription.EventFilter.IsEmpty())
+	{
+		IsMatchAllEventBucketDirty = true;
+		return;
+	}
+
+	if (Subscription.OnlyMatchExactEvent)
+	{
+		for (const FGameplayTag& EventTag : Subscription.EventFilter)
+		{
+			DirtyExactEventBuckets.Add(EventTag);
+		}
+		return;
+	}
+
+	for (const FGameplayTag& EventTag : Subscription.EventFilter.GetGameplayTagParents())
+	{
+		DirtyParentEventBuckets.Add(EventTag);
+	}
+}
+
+void FEventSubscriptionBuckets::Compact(TFunctionRef<bool(FEventSubscriptionHandle)> IsRemoved)
+{
+	// RemoveAll keeps the order of the remaining entries so the buckets stay sorted
+	auto IsEntryRemoved = [&IsRemoved](const FEventSubscriptionBucketEntry& Entry)
+	{
+		return IsRemoved(Entry.Handle);
+	};
+
+	auto CompactBuckets = [&IsEntryRemoved](TMap<FGameplayTag, TArray<FEventSubscriptionBucketEntry>>& Buckets, TSet<FGameplayTag>& DirtyEventTags)
+	{
+		for (const FGameplayTag& EventTag : DirtyEventTags)
+		{
+			if (TArray<FEventSubscriptionBucketEntry>* Bucket = Buckets.Find(EventTag))
+			{
+				Bucket->RemoveAll(IsEntryRemoved);
+
+				if (Bucket->IsEmpty())
+				{
+					Buckets.Remove(EventTag);
+				}
+			}
+		}
+		DirtyEventTags.Reset();
+	};
+
+	CompactBuckets(ExactEventBuckets, DirtyExactEventBuckets);
+	CompactBuckets(ParentEventBuckets, DirtyParentEventBuckets);
+
+	if (IsMatchAllEventBucketDirty)
+	{
+		MatchAllEventBucket.RemoveAll(IsEntryRemoved);
+		IsMatchAllEventBucketDirty = false;
+	}
 }
@@ -2,17 +2,19 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
 #include "SimpleEventTypes.h"
 #include "SimpleEventSubsystem.generated.h"
 
 UCLASS()
-class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleEventSubsystem : public UGameInstanceSubsystem
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleEventSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 
 public:
 	/**
 	 * Sends an event to all listeners. The event is not replicated.
+	 * If the sender is in a world, only listeners in the same world (or not in any world) receive the event.
 	 *
 	 * @param EventTag The gameplay tag identifying the event. (mandatory)
 	 * @param DomainTag The domain tag categorizing the event. (optional)
@@ -20,11 +22,35 @@ public:
 	 * @param Sender The actor that sent the event. (optional)
 	 * @param ListenerFilter Only send the event to listeners in this list. If not set, the event will be sent to all listeners.
 	 */
-	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem", meta=(AdvancedDisplay=4, AutoCreateRefTerm = "ListenerFilter"))
-	void SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload, UObject* Sender, TArray<UObject*> ListenerFilter);
+	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem", meta=(AdvancedDisplay=4, AutoCreateRefTerm = "Payload,ListenerFilter"))
+	void SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender, const TArray<UObject*>& ListenerFilter);
+
+	/**
+	 * Native version of SendEvent. The payload and listener filter are passed by reference all the way to the listeners
+	 * and subscriptions aren't copied, so sending an event doesn't allocate once the subsystem has warmed up.
+	 *
+	 * @param World Only listeners in this world (and listeners that aren't in any world) receive the event. If null,
+	 * the world of the Sender is used. Events without either are sent to listeners in every world.
+	 */
+	void DispatchEvent(FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender,
+	                   TConstArrayView<UObject*> ListenerFilter = {}, const UWorld* World = nullptr);
+
+	/**
+	 * Typed version of SendEvent for C++. Listeners added with ListenForEvent<T> receive a reference to Payload directly.
+	 * An FInstancedStruct copy of the payload is only made if the event is queued or reaches a listener that takes one.
+	 * World works the same as in DispatchEvent.
+	 */
+	template <typename T>
+	void SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, const T& Payload, UObject* Sender = nullptr,
+	               TConstArrayView<UObject*> ListenerFilter = {}, const UWorld* World = nullptr)
+	{
+		static_assert(!std::is_same_v<T, FInstancedStruct>, "Use DispatchEvent to send an FInstancedStruct payload.");
+		DispatchEventInternal(EventTag, DomainTag, FConstStructView::Make(Payload), nullptr, Sender, ListenerFilter, World);
+	}
 
 	/**
 	 * Register a listener to receive events. The listener will be notified when an event is sent that matches the provided filters.
+	 * Listeners that are in a world only receive events sent from their own world or without a world.
 	 *
 	 * @param Listener The object listening for the event (mandatory).
 	 * @param OnlyTriggerOnce If true, the listener will only be notified once and then automatically unsubscribed.
@@ -35,6 +61,7 @@ public:
 	 * @param SenderFilter Only respond to the event if the sender is in this list. If not set, the listener will accept events from any sender.
 	 * @param OnlyMatchExactEvent If true, only listen for events that match the filter tags exactly. i.e "A.B" will only match "A.B" and not "A.B.C".
 	 * @param OnlyMatchExactDomain If true, only listen for events that match the domain tags exactly. i.e "A.B" will only match "A.B" and not "A.B.C".
+	 * @param Priority Listeners with a higher priority are called first. Listeners with the same priority are called from the newest to the oldest.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem", meta=(AdvancedDisplay=5, AutoCreateRefTerm = "PayloadFilter,SenderFilter"))
 	FGuid ListenForEvent(
@@ -46,7 +73,77 @@ public:
 		TArray<UScriptStruct*> PayloadFilter,
 		TArray<UObject*> SenderFilter,
 		bool OnlyMatchExactEvent = true,
-		bool OnlyMatchExactDomain = true);
+		bool OnlyMatchExactDomain = true,
+		int32 Priority = 0);
+
+	/**
+	 * Native version of ListenForEvent. The delegate receives the payload by reference and isn't called through
+	 * the reflection system, so prefer this overload when listening from C++.
+	 */
+	FGuid ListenForEvent(
+		UObject* Listener,
+		bool OnlyTriggerOnce,
+		const FGameplayTagContainer& EventFilter,
+		const FGameplayTagContainer& DomainFilter,
+		const FSimpleNativeEventDelegate& EventReceivedDelegate,
+		TConstArrayView<UScriptStruct*> PayloadFilter = {},
+		TConstArrayView<UObject*> SenderFilter = {},
+		bool OnlyMatchExactEvent = true,
+		bool OnlyMatchExactDomain = true,
+		int32 Priority = 0);
+
+	/**
+	 * Native version of ListenForEvent for listeners that can consume events, e.g. a damage mitigation hook that
+	 * handles the damage itself. When the delegate returns true the listeners after it aren't called, so consuming
+	 * listeners usually have a higher Priority than the listeners they should hide the event from.
+	 */
+	FGuid ListenForEvent(
+		UObject* Listener,
+		bool OnlyTriggerOnce,
+		const FGameplayTagContainer& EventFilter,
+		const FGameplayTagContainer& DomainFilter,
+		const FSimpleConsumingEventDelegate& EventReceivedDelegate,
+		TConstArrayView<UScriptStruct*> PayloadFilter = {},
+		TConstArrayView<UObject*> SenderFilter = {},
+		bool OnlyMatchExactEvent = true,
+		bool OnlyMatchExactDomain = true,
+		int32 Priority = 0);
+
+	/**
+	 * Typed version of ListenForEvent for C++. Only events with a payload of type T are received and the delegate is
+	 * called with the payload struct itself, so there is no need to check the type of the payload or unwrap it.
+	 */
+	template <typename T>
+	FGuid ListenForEvent(
+		UObject* Listener,
+		bool OnlyTriggerOnce,
+		const FGameplayTagContainer& EventFilter,
+		const FGameplayTagContainer& DomainFilter,
+		TSimpleEventDelegate<T> EventReceivedDelegate,
+		TConstArrayView<UObject*> SenderFilter = {},
+		bool OnlyMatchExactEvent = true,
+		bool OnlyMatchExactDomain = true,
+		int32 Priority = 0)
+	{
+		static_assert(!std::is_same_v<T, FInstancedStruct>, "Use the FSimpleNativeEventDelegate overload of ListenForEvent to receive FInstancedStruct payloads.");
+
+		FEventSubscription Subscription;
+
+		if (EventReceivedDelegate.IsBound())
+		{
+			Subscription.StructViewCallbackDelegate.BindLambda(
+				[TypedDelegate = MoveTemp(EventReceivedDelegate)](FGameplayTag EventTag, FGameplayTag DomainTag, FConstStructView Payload, UObject* Sender)
+				{
+					// The payload filter only lets payloads of type T through
+					TypedDelegate.ExecuteIfBound(EventTag, DomainTag, *reinterpret_cast<const T*>(Payload.GetMemory()), Sender);
+				});
+		}
+
+		UScriptStruct* PayloadType = TBaseStructure<T>::Get();
+
+		return ListenForEventInternal(MoveTemp(Subscription), Listener, OnlyTriggerOnce, EventFilter, DomainFilter,
+		                              MakeArrayView(&PayloadType, 1), SenderFilter, OnlyMatchExactEvent, OnlyMatchExactDomain, Priority);
+	}
 
 	/**
 	 * Stop listening for an event on a listener.
@@ -74,9 +171,227 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem")
 	void StopListeningForAllEvents(UObject* Listener);
 
+	/**
+	 * Stop listening for an event using the handle of the subscription. Same as StopListeningForEventSubscriptionByID
+	 * without the ID lookup.
+	 *
+	 * @param SubscriptionHandle The handle of the event subscription to stop listening for (mandatory).
+	 */
+	void StopListeningForEventSubscription(FEventSubscriptionHandle SubscriptionHandle);
+
+	/**
+	 * Returns the handle of the subscription with this ID or an invalid handle if there is no such subscription.
+	 */
+	FEventSubscriptionHandle GetEventSubscriptionHandle(FGuid EventSubscriptionID) const;
+
 	UPROPERTY(BlueprintAssignable)
 	FOnEventSubscriptionRemoved OnEventSubscriptionRemoved;
 
+	/**
+	 * Events with these tags (or their child tags) are queued and delivered at the flush point instead of immediately.
+	 * While queued, events with the same sender, event tag and domain are coalesced and only the latest payload is delivered.
+	 * Events sent with a ListenerFilter are always delivered immediately.
+	 *
+	 * @param EventTags The event tags to queue.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem|Queue")
+	void AddCoalescableEventTags(const FGameplayTagContainer& EventTags);
+
+	/**
+	 * Events with these tags are delivered immediately again. Events that are already queued are still delivered at the next flush.
+	 *
+	 * @param EventTags The event tags to stop queueing.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem|Queue")
+	void RemoveCoalescableEventTags(const FGameplayTagContainer& EventTags);
+
+	/**
+	 * Sets when queued events are delivered. Defaults to the end of the frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem|Queue")
+	void SetEventFlushPoint(ESimpleEventFlushPoint NewFlushPoint);
+
+	/**
+	 * Delivers all queued events in the order they were first queued. Events sent by listeners during the flush are
+	 * queued for the next flush.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem|Queue")
+	void FlushQueuedEvents();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "SimpleEventSubsystem|Queue")
+	int32 GetNumQueuedEvents() const { return QueuedEvents.Num(); }
+
+	/**
+	 * Logs the event tags and listeners with the highest cumulative dispatch time since the stats were last reset.
+	 * Event tags are only recorded while SimpleGAS.Events.Stats is 1 or higher and listeners while it is 2.
+	 * Also available as the SimpleGAS.Events.DumpStats console command.
+	 *
+	 * @param Ar Where to write the stats.
+	 * @param NumToDump How many event tags and listeners to list.
+	 */
+	void DumpEventStats(FOutputDevice& Ar, int32 NumToDump) const;
+
+	void ResetEventStats();
+
+	// USubsystem overrides
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject overrides
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+
 private:
-	TArray<FEventSubscription> EventSubscriptions;
+	/**
+	 * Queues the event if it is coalescable, otherwise delivers it. InstancedPayload is the FInstancedStruct Payload views,
+	 * if the sender has one. Without it an FInstancedStruct is only made for listeners that need one.
+	 */
+	void DispatchEventInternal(FGameplayTag EventTag, FGameplayTag DomainTag, FConstStructView Payload, const FInstancedStruct* InstancedPayload,
+	                           UObject* Sender, TConstArrayView<UObject*> ListenerFilter, const UWorld* World);
+
+	/* Calls every listener that matches the event. This is DispatchEventInternal without the queue. */
+	void DeliverEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FConstStructView Payload, const FInstancedStruct* InstancedPayload,
+	                  UObject* Sender, TConstArrayView<UObject*> ListenerFilter, const UWorld* World);
+
+	void QueueEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FConstStructView Payload, UObject* Sender, const UWorld* World);
+
+	/* The world of the sender, looked up once per sender and then read from SenderWorlds. */
+	const UWorld* GetSenderWorld(const UObject* Sender);
+	void OnEndFrame();
+
+	/* Removes the subscriptions of listeners in the world that is being cleaned up. */
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/* Listeners only become invalid when they're garbage collected, so this flags the next Tick to look for them. */
+	void OnPostGarbageCollect();
+
+	/**
+	 * Removes the subscriptions of garbage collected listeners that forgot to stop listening. DispatchEvent removes them
+	 * too, but a subscription with a SenderFilter is never dispatched to again once its senders are gone as well.
+	 */
+	void RemoveInvalidListenerSubscriptions();
+
+	/**
+	 * Subscriptions are heap allocated so references to them stay valid while listeners add new subscriptions
+	 * during DispatchEvent. A freed slot keeps its allocation for the next subscription that reuses the slot.
+	 */
+	struct FEventSubscriptionSlot
+	{
+		TUniquePtr<FEventSubscription> Subscription;
+		uint32 Generation = 0;
+		bool IsOccupied = false;
+	};
+
+	/* Fills in the filters of a subscription whose callback delegate is already set and adds it. Fails if no callback delegate is bound. */
+	FGuid ListenForEventInternal(
+		FEventSubscription&& Subscription,
+		UObject* Listener,
+		bool OnlyTriggerOnce,
+		const FGameplayTagContainer& EventFilter,
+		const FGameplayTagContainer& DomainFilter,
+		TConstArrayView<UScriptStruct*> PayloadFilter,
+		TConstArrayView<UObject*> SenderFilter,
+		bool OnlyMatchExactEvent,
+		bool OnlyMatchExactDomain,
+		int32 Priority);
+
+	FEventSubscriptionHandle AddSubscription(FEventSubscription&& Subscription);
+	FEventSubscription* ResolveSubscription(FEventSubscriptionHandle SubscriptionHandle) const;
+
+	/**
+	 * Marks the subscription as removed. It is skipped by DispatchEvent from now on and its slot is freed the next time
+	 * subscriptions are compacted. Returns false if the subscription was already removed.
+	 */
+	bool RemoveSubscription(FEventSubscriptionHandle SubscriptionHandle);
+
+	/* Frees the slots of removed subscriptions and removes them from the dispatch table. Does nothing during DispatchEvent. */
+	void CompactSubscriptions();
+
+	/**
+	 * Adds the subscription to its listener world's shard, in the event tag buckets of every sender in its SenderFilter
+	 * or in the sender agnostic buckets if it has no SenderFilter. DispatchEvent then only looks at the buckets for its
+	 * world, sender and event tag.
+	 */
+	void AddSubscriptionToDispatchTable(FEventSubscriptionHandle SubscriptionHandle, const FEventSubscription& Subscription);
+	void MarkSubscriptionRemovedFromDispatchTable(const FEventSubscription& Subscription);
+
+	TArray<FEventSubscriptionSlot> SubscriptionSlots;
+	TArray<int32> FreeSubscriptionSlots;
+	TArray<FEventSubscriptionHandle> PendingRemovalSubscriptions;
+
+	// Lets the FGuid based API find subscriptions without searching the slots
+	TMap<FGuid, FEventSubscriptionHandle> SubscriptionHandles;
+
+	// Subscriptions of each listener, used by StopListeningForAllEvents and StopListeningForEventsByFilter
+	TMap<TWeakObjectPtr<UObject>, TArray<FEventSubscriptionHandle>> ListenerSubscriptions;
+
+	/* The dispatch table for the subscriptions of the listeners in one world. */
+	struct FEventWorldShard
+	{
+		// Subscriptions without a SenderFilter
+		FEventSubscriptionBuckets SenderAgnosticSubscriptions;
+
+		// Subscriptions with a SenderFilter, keyed by each sender in the filter
+		TMap<TWeakObjectPtr<UObject>, FEventSubscriptionBuckets> SenderSubscriptions;
+
+		// Senders whose buckets contain removed subscriptions since the last compaction
+		TSet<TWeakObjectPtr<UObject>> DirtySenderSubscriptions;
+		bool AreSenderAgnosticSubscriptionsDirty = false;
+
+		bool IsEmpty() const
+		{
+			return SenderAgnosticSubscriptions.IsEmpty() && SenderSubscriptions.IsEmpty();
+		}
+	};
+
+	// Keyed by the world of the listeners. Listeners that aren't in a world are in the shard of the null world.
+	TMap<TObjectKey<UWorld>, FEventWorldShard> WorldShards;
+
+	// Shards that contain removed subscriptions since the last compaction
+	TSet<TObjectKey<UWorld>> DirtyWorldShards;
+
+	uint64 NextSubscriptionOrder = 0;
+
+	// How many DispatchEvent calls are currently running. Subscriptions are only compacted when this is 0.
+	int32 DispatchDepth = 0;
+
+	// Reused candidate lists, one per DispatchDepth, so gathering subscriptions doesn't allocate for every event.
+	// TIndirectArray keeps each list at the same address when a nested DispatchEvent adds another one.
+	TIndirectArray<TArray<FEventSubscriptionBucketEntry>> CandidateSubscriptionLists;
+
+	FGameplayTagContainer CoalescableEventTags;
+	ESimpleEventFlushPoint FlushPoint = ESimpleEventFlushPoint::EndOfFrame;
+
+	UPROPERTY()
+	TArray<FSimpleQueuedEvent> QueuedEvents;
+
+	// The events being delivered by FlushQueuedEvents. Kept around so flushing doesn't allocate every frame.
+	UPROPERTY()
+	TArray<FSimpleQueuedEvent> FlushingEvents;
+
+	// Index into QueuedEvents for each queued world, sender, event tag and domain
+	TMap<TTuple<TObjectKey<UWorld>, TWeakObjectPtr<UObject>, FGameplayTag, FGameplayTag>, int32> QueuedEventIndices;
+
+	// The world of each sender that dispatched an event without one. Entries are removed when their world is cleaned up
+	// and when their sender is garbage collected. Senders that aren't in a world aren't cached.
+	TMap<TObjectKey<UObject>, TObjectKey<UWorld>> SenderWorlds;
+
+	/* Cumulative cost of the events sent with one event tag or of the calls to one listener. */
+	struct FEventDispatchStats
+	{
+		uint64 Count = 0;
+		uint64 Cycles = 0;
+	};
+
+	// Only recorded while SimpleGAS.Events.Stats is enabled. The time of an event tag includes the events its listeners sent.
+	TMap<FGameplayTag, FEventDispatchStats> EventTagStats;
+	TMap<FName, FEventDispatchStats> ListenerStats;
+
+	bool IsFlushingQueuedEvents = false;
+	bool HasGarbageCollectedSinceLastSweep = false;
+	FDelegateHandle EndFrameDelegateHandle;
+	FDelegateHandle WorldCleanupDelegateHandle;
+	FDelegateHandle PostGarbageCollectDelegateHandle;
 };
\ No newline at end of file
@@ -2,11 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
 
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5)
 	#include "StructUtils/InstancedStruct.h"
+	#include "StructUtils/StructView.h"
 #else
 	#include "InstancedStruct.h"
+	#include "StructView.h"
 #endif
 
 #include "SimpleEventTypes.generated.h"
@@ -18,8 +21,38 @@ DECLARE_DYNAMIC_DELEGATE_FourParams(
 	FInstancedStruct, Payload,
 	UObject*, Sender);
 
+/* Native version of FSimpleEventDelegate. Receives the payload by reference and can be bound to lambdas and non UFUNCTION members. */
+DECLARE_DELEGATE_FourParams(FSimpleNativeEventDelegate, FGameplayTag /*EventTag*/, FGameplayTag /*Domain*/, const FInstancedStruct& /*Payload*/, UObject* /*Sender*/);
+
+/**
+ * Native listener that can consume the event. Returning true stops the event from reaching listeners that would have
+ * been called after this one.
+ */
+DECLARE_DELEGATE_RetVal_FourParams(bool, FSimpleConsumingEventDelegate, FGameplayTag /*EventTag*/, FGameplayTag /*Domain*/, const FInstancedStruct& /*Payload*/, UObject* /*Sender*/);
+
+/* Delegate for the typed USimpleEventSubsystem::ListenForEvent<T>. Receives the payload as the struct it was sent as. */
+template <typename T>
+using TSimpleEventDelegate = TDelegate<void(FGameplayTag /*EventTag*/, FGameplayTag /*Domain*/, const T& /*Payload*/, UObject* /*Sender*/)>;
+
+/* Used internally by typed subscriptions to receive the payload without wrapping it in an FInstancedStruct. */
+DECLARE_DELEGATE_FourParams(FSimpleStructViewEventDelegate, FGameplayTag /*EventTag*/, FGameplayTag /*Domain*/, FConstStructView /*Payload*/, UObject* /*Sender*/);
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEventSubscriptionRemoved, FGuid, EventSubscriptionID);
 
+/**
+ * When USimpleEventSubsystem delivers the events it queued for coalescable event tags.
+ */
+UENUM(BlueprintType)
+enum class ESimpleEventFlushPoint : uint8
+{
+	/* Queued events are delivered at the end of every engine frame */
+	EndOfFrame,
+	/* Queued events are delivered when the event subsystem ticks, before the end of the frame */
+	SubsystemTick,
+	/* Queued events are only delivered when USimpleEventSubsystem::FlushQueuedEvents is called */
+	Manual,
+};
+
 USTRUCT(BlueprintType)
 struct FEventSubscription
 {
@@ -36,6 +69,22 @@ struct FEventSubscription
 	 */
 	UPROPERTY()
 	FSimpleEventDelegate CallbackDelegate;
+
+	/**
+	 * Native alternative to CallbackDelegate. If bound it is called instead of CallbackDelegate.
+	 */
+	FSimpleNativeEventDelegate NativeCallbackDelegate;
+
+	/**
+	 * Set by the typed ListenForEvent<T>. If bound it is called instead of the other delegates. PayloadFilter then
+	 * contains exactly the struct type the delegate expects.
+	 */
+	FSimpleStructViewEventDelegate StructViewCallbackDelegate;
+
+	/**
+	 * Native alternative to CallbackDelegate that can consume the event. If bound it is called instead of CallbackDelegate.
+	 */
+	FSimpleConsumingEventDelegate ConsumingCallbackDelegate;
 	
 	/**
 	 * The object to call the delegate on
@@ -88,8 +137,165 @@ struct FEventSubscription
 	UPROPERTY()
 	bool OnlyMatchExactDomain = true;
 
+	/**
+	 * Listeners with a higher priority are called first. Listeners with the same priority are called from the newest to the oldest.
+	 */
+	UPROPERTY()
+	int32 Priority = 0;
+
+	/**
+	 * The world of the ListenerObject when the subscription was added. Null if the listener isn't in a world, in which
+	 * case the subscription receives events from every world.
+	 */
+	TObjectKey<UWorld> ListenerWorld;
+
+	/**
+	 * Increases with every subscription added to the event subsystem. Listeners with the same priority are called from
+	 * the highest to the lowest.
+	 */
+	uint64 SubscriptionOrder = 0;
+
+	/**
+	 * Identifies the listener's class and callback in the event stats, e.g. "BP_HealthBar_C::OnHealthChanged".
+	 * Set by the event subsystem the first time the subscription's call is recorded with SimpleGAS.Events.Stats 2.
+	 */
+	FName StatName;
+
+	/**
+	 * Set when the subscription is removed. DispatchEvent skips it until the event subsystem compacts its subscriptions.
+	 */
+	bool IsPendingRemoval = false;
+
 	bool operator==(const FEventSubscription& Other) const
 	{
 		return EventSubscriptionID == Other.EventSubscriptionID;
 	}
-};
\ No newline at end of file
+};
+
+/**
+ * An event waiting in USimpleEventSubsystem's queue. Sending the same event tag and domain from the same sender again
+ * before the queue is flushed replaces the payload instead of queueing another event.
+ */
+USTRUCT()
+struct FSimpleQueuedEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag EventTag;
+
+	UPROPERTY()
+	FGameplayTag DomainTag;
+
+	UPROPERTY()
+	FInstancedStruct Payload;
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> Sender;
+
+	TWeakObjectPtr<const UWorld> World;
+
+	// Let us tell an event sent without a sender or world apart from one whose sender or world was destroyed before the flush
+	bool HasSender = false;
+	bool HasWorld = false;
+};
+
+/**
+ * Identifies a subscription slot in USimpleEventSubsystem. The slot's generation changes every time the slot is freed
+ * so a handle to a removed subscription never resolves to a newer subscription that reused the slot.
+ */
+struct FEventSubscriptionHandle
+{
+	int32 SlotIndex = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsValid() const
+	{
+		return SlotIndex != INDEX_NONE;
+	}
+
+	bool operator==(const FEventSubscriptionHandle& Other) const
+	{
+		return SlotIndex == Other.SlotIndex && Generation == Other.Generation;
+	}
+
+	friend uint32 GetTypeHash(const FEventSubscriptionHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.SlotIndex), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/**
+ * A subscription in an FEventSubscriptionBuckets bucket. Keeps the subscription's sort key next to its handle so
+ * buckets can be kept sorted and merged without resolving the handles.
+ */
+struct FEventSubscriptionBucketEntry
+{
+	FEventSubscriptionHandle Handle;
+	int32 Priority = 0;
+	uint64 SubscriptionOrder = 0;
+
+	/* Higher priorities are called first, then newer subscriptions. */
+	bool IsCalledBefore(const FEventSubscriptionBucketEntry& Other) const
+	{
+		return Priority != Other.Priority ? Priority > Other.Priority : SubscriptionOrder > Other.SubscriptionOrder;
+	}
+};
+
+/**
+ * Event tag buckets USimpleEventSubsystem uses to find the subscriptions an event can match without testing every
+ * subscription's EventFilter. Each bucket is sorted in reverse call order, so the last entry is the first listener to
+ * call. Removed subscriptions stay in their buckets until Compact is called.
+ */
+struct FEventSubscriptionBuckets
+{
+	// Subscriptions with OnlyMatchExactEvent = true, keyed by each tag in their EventFilter
+	TMap<FGameplayTag, TArray<FEventSubscriptionBucketEntry>> ExactEventBuckets;
+
+	// Subscriptions with OnlyMatchExactEvent = false, keyed by each tag in their EventFilter and its parent tags
+	TMap<FGameplayTag, TArray<FEventSubscriptionBucketEntry>> ParentEventBuckets;
+
+	// Subscriptions with an empty EventFilter. These match every event.
+	TArray<FEventSubscriptionBucketEntry> MatchAllEventBucket;
+
+	void AddSubscription(FEventSubscriptionHandle Handle, const FEventSubscription& Subscription);
+
+	/* Remembers which buckets contain the subscription so the next Compact only has to visit those buckets. */
+	void MarkSubscriptionRemoved(const FEventSubscription& Subscription);
+
+	/* Removes every handle for which IsRemoved returns true from the buckets passed to MarkSubscriptionRemoved. */
+	void Compact(TFunctionRef<bool(FEventSubscriptionHandle)> IsRemoved);
+
+	/* Calls Visitor with every bucket that can contain subscriptions matching EventTag. */
+	template <typename VisitorType>
+	void ForEachMatchingBucket(const FGameplayTag& EventTag, VisitorType&& Visitor) const
+	{
+		if (EventTag.IsValid())
+		{
+			if (const TArray<FEventSubscriptionBucketEntry>* ExactBucket = ExactEventBuckets.Find(EventTag))
+			{
+				Visitor(*ExactBucket);
+			}
+
+			if (const TArray<FEventSubscriptionBucketEntry>* ParentBucket = ParentEventBuckets.Find(EventTag))
+			{
+				Visitor(*ParentBucket);
+			}
+		}
+
+		if (!MatchAllEventBucket.IsEmpty())
+		{
+			Visitor(MatchAllEventBucket);
+		}
+	}
+
+	bool IsEmpty() const
+	{
+		return ExactEventBuckets.IsEmpty() && ParentEventBuckets.IsEmpty() && MatchAllEventBucket.IsEmpty();
+	}
+
+private:
+	TSet<FGameplayTag> DirtyExactEventBuckets;
+	TSet<FGameplayTag> DirtyParentEventBuckets;
+	bool IsMatchAllEventBucketDirty = false;
+};
@@ -24,7 +24,6 @@ UWaitForSimpleEvent* UWaitForSimpleEvent::WaitForSimpleEvent(
 	Task->SenderFilter = SenderFilter;
 	Task->OnlyMatchExactEvent = OnlyMatchExactEvent;
 	Task->OnlyMatchExactDomain = OnlyMatchExactDomain;
-	Task->EventCallbackDelegate = FSimpleEventDelegate();
 
 	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
@@ -45,12 +44,12 @@ void UWaitForSimpleEvent::Activate()
 		return;
 	}
 
-	EventCallbackDelegate.BindDynamic(this, &UWaitForSimpleEvent::OnSimpleEventReceived);
-	EventID = EventSubsystem->ListenForEvent(Listener, OnlyTriggerOnce, EventFilter, DomainFilter, EventCallbackDelegate, PayloadFilter, SenderFilter);
+	EventID = EventSubsystem->ListenForEvent(Listener, OnlyTriggerOnce, EventFilter, DomainFilter,
+		FSimpleNativeEventDelegate::CreateUObject(this, &UWaitForSimpleEvent::OnSimpleEventReceived), PayloadFilter, SenderFilter);
 	EventSubsystem->OnEventSubscriptionRemoved.AddDynamic(this, &UWaitForSimpleEvent::OnEventSubscriptionRemoved);
 }
 
-void UWaitForSimpleEvent::OnSimpleEventReceived(FGameplayTag AbilityTag, FGameplayTag DomainTag, FInstancedStruct Payload, UObject* Sender)
+void UWaitForSimpleEvent::OnSimpleEventReceived(FGameplayTag AbilityTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender)
 {
 	OnEventReceived.Broadcast(AbilityTag, DomainTag, Payload, Sender, EventID);
 
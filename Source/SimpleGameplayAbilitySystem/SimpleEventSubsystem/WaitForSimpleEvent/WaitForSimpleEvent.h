@@ -38,8 +38,7 @@ public:
 	virtual void Activate() override;
 
 protected:
-	UFUNCTION()
-	void OnSimpleEventReceived(FGameplayTag AbilityTag, FGameplayTag DomainTag, FInstancedStruct Payload, UObject* Sender = nullptr);
+	void OnSimpleEventReceived(FGameplayTag AbilityTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender);
 
 	UFUNCTION()
 	void OnEventSubscriptionRemoved(FGuid SubscriptionID);
@@ -55,5 +54,4 @@ protected:
 	TArray<UObject*> SenderFilter;
 	bool OnlyMatchExactEvent = true;
 	bool OnlyMatchExactDomain = true;
-	FSimpleEventDelegate EventCallbackDelegate;
 };
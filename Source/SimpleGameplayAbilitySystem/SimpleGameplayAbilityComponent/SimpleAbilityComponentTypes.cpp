@@ -1,5 +1,13 @@
 #include "SimpleAbilityComponentTypes.h"
 
+#include "GameplayTagsManager.h"
+
+uint32 FAttributeTagIndex::MakeGeneration()
+{
+	static uint32 NextGeneration = 0;
+	return ++NextGeneration;
+}
+
 void FFloatAttribute::PreReplicatedRemove(const struct FFloatAttributeContainer& InArraySerializer)
 {
 	InArraySerializer.OnFloatAttributeRemoved.ExecuteIfBound(*this);
@@ -14,3 +22,300 @@ void FFloatAttribute::PostReplicatedChange(const struct FFloatAttributeContainer
 {
 	InArraySerializer.OnFloatAttributeChanged.ExecuteIfBound(*this);
 }
+
+FGameplayTagCounter* FGameplayTagCounterIndex::Find(TArray<FGameplayTagCounter>& TagCounters, const FGameplayTag& Tag) const
+{
+	const int32* TagIndex = Indices.Find(Tag);
+	return TagIndex ? &TagCounters[*TagIndex] : nullptr;
+}
+
+FGameplayTagCounter& FGameplayTagCounterIndex::Add(TArray<FGameplayTagCounter>& TagCounters, const FGameplayTagCounter& TagCounter)
+{
+	const int32 TagIndex = TagCounters.Add(TagCounter);
+	Indices.Add(TagCounter.GameplayTag, TagIndex);
+	Tags.AddTag(TagCounter.GameplayTag);
+	AddToBitSet(TagCounter.GameplayTag);
+
+	return TagCounters[TagIndex];
+}
+
+bool FGameplayTagCounterIndex::Remove(TArray<FGameplayTagCounter>& TagCounters, const FGameplayTag& Tag)
+{
+	int32 TagIndex = INDEX_NONE;
+
+	if (!Indices.RemoveAndCopyValue(Tag, TagIndex))
+	{
+		return false;
+	}
+
+	TagCounters.RemoveAtSwap(TagIndex);
+
+	if (TagCounters.IsValidIndex(TagIndex))
+	{
+		Indices.Add(TagCounters[TagIndex].GameplayTag, TagIndex);
+	}
+
+	Tags.RemoveTag(Tag);
+
+	if (UseBitSet)
+	{
+		if (BitSet.IsUpToDate())
+		{
+			BitSet.RemoveTag(Tag);
+		}
+		else
+		{
+			BitSet.Rebuild(Tags);
+		}
+	}
+
+	return true;
+}
+
+void FGameplayTagCounterIndex::Rebuild(const TArray<FGameplayTagCounter>& TagCounters)
+{
+	Indices.Reset();
+	Tags.Reset();
+
+	for (int32 TagIndex = 0; TagIndex < TagCounters.Num(); ++TagIndex)
+	{
+		Indices.Add(TagCounters[TagIndex].GameplayTag, TagIndex);
+		Tags.AddTag(TagCounters[TagIndex].GameplayTag);
+	}
+
+	if (UseBitSet)
+	{
+		BitSet.Rebuild(Tags);
+	}
+}
+
+void FGameplayTagCounterIndex::SetUseBitSet(bool InUseBitSet)
+{
+	UseBitSet = InUseBitSet;
+
+	if (UseBitSet)
+	{
+		BitSet.Rebuild(Tags);
+	}
+	else
+	{
+		BitSet = FGameplayTagBitSet();
+	}
+}
+
+void FGameplayTagCounterIndex::AddToBitSet(const FGameplayTag& Tag)
+{
+	if (!UseBitSet)
+	{
+		return;
+	}
+
+	// Tags is already up to date, so a rebuild also picks up the new tag
+	if (!BitSet.IsUpToDate() || !BitSet.AddTag(Tag))
+	{
+		BitSet.Rebuild(Tags);
+	}
+}
+
+static uint32 GetCurrentTagNetIndexHash()
+{
+	return UGameplayTagsManager::Get().GetNetworkGameplayTagNodeIndexHash();
+}
+
+bool FGameplayTagBitSet::AddTag(const FGameplayTag& Tag)
+{
+	const FGameplayTagNetIndex NetIndex = UGameplayTagsManager::Get().GetNetIndexFromTag(Tag);
+
+	if (NetIndex == INVALID_TAGNETINDEX)
+	{
+		return false;
+	}
+
+	const int32 WordIndex = NetIndex / 64;
+
+	if (WordIndex >= Words.Num())
+	{
+		Words.SetNumZeroed(WordIndex + 1);
+	}
+
+	Words[WordIndex] |= uint64(1) << (NetIndex % 64);
+	return true;
+}
+
+void FGameplayTagBitSet::RemoveTag(const FGameplayTag& Tag)
+{
+	const FGameplayTagNetIndex NetIndex = UGameplayTagsManager::Get().GetNetIndexFromTag(Tag);
+	const int32 WordIndex = NetIndex / 64;
+
+	if (NetIndex != INVALID_TAGNETINDEX && Words.IsValidIndex(WordIndex))
+	{
+		Words[WordIndex] &= ~(uint64(1) << (NetIndex % 64));
+	}
+}
+
+void FGameplayTagBitSet::Rebuild(const FGameplayTagContainer& Tags)
+{
+	Words.Reset();
+	NetIndexHash = GetCurrentTagNetIndexHash();
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		AddTag(Tag);
+	}
+}
+
+bool FGameplayTagBitSet::IsUpToDate() const
+{
+	return NetIndexHash == GetCurrentTagNetIndexHash();
+}
+
+FGameplayTagBitMask::FGameplayTagBitMask(const FGameplayTagContainer& InTags)
+	: Tags(InTags)
+{
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+
+	NetIndexHash = TagsManager.GetNetworkGameplayTagNodeIndexHash();
+	CanUseBits = true;
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Tag);
+
+		if (NetIndex == INVALID_TAGNETINDEX)
+		{
+			CanUseBits = false;
+			Words.Reset();
+			return;
+		}
+
+		const int32 WordIndex = NetIndex / 64;
+		const uint64 Bit = uint64(1) << (NetIndex % 64);
+
+		TPair<int32, uint64>* Word = Words.FindByPredicate([WordIndex](const TPair<int32, uint64>& MaskWord)
+		{
+			return MaskWord.Key == WordIndex;
+		});
+
+		if (Word)
+		{
+			Word->Value |= Bit;
+		}
+		else
+		{
+			Words.Emplace(WordIndex, Bit);
+		}
+	}
+}
+
+bool FGameplayTagBitMask::IsUpToDate() const
+{
+	return NetIndexHash == GetCurrentTagNetIndexHash();
+}
+
+bool FGameplayTagBitMask::IsAllIn(const FGameplayTagBitSet& BitSet) const
+{
+	for (const TPair<int32, uint64>& Word : Words)
+	{
+		if (!BitSet.Words.IsValidIndex(Word.Key) || (BitSet.Words[Word.Key] & Word.Value) != Word.Value)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FGameplayTagBitMask::IsAnyIn(const FGameplayTagBitSet& BitSet) const
+{
+	for (const TPair<int32, uint64>& Word : Words)
+	{
+		if (BitSet.Words.IsValidIndex(Word.Key) && (BitSet.Words[Word.Key] & Word.Value) != 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FHandledEventIDCache::Initialize(int32 InCapacity, double InExpiryTime)
+{
+	Capacity = FMath::Max(InCapacity, 1);
+	ExpiryTime = InExpiryTime;
+
+	Entries.Reset();
+	Slots.Reset();
+	OldestEntry = 0;
+	NumEntries = 0;
+
+	NumHits = 0;
+	NumMisses = 0;
+	NumEvictions = 0;
+}
+
+bool FHandledEventIDCache::Consume(const FGuid& EventID, double CurrentTime)
+{
+	int32 EntryIndex = INDEX_NONE;
+
+	if (!Slots.RemoveAndCopyValue(EventID, EntryIndex))
+	{
+		NumMisses++;
+		return false;
+	}
+
+	const bool HasExpired = ExpiryTime > 0 && Entries[EntryIndex].TimeStamp + ExpiryTime < CurrentTime;
+	Entries[EntryIndex].EventID.Invalidate();
+
+	if (HasExpired)
+	{
+		NumEvictions++;
+		NumMisses++;
+		return false;
+	}
+
+	NumHits++;
+	return true;
+}
+
+void FHandledEventIDCache::Add(const FGuid& EventID, double CurrentTime)
+{
+	if (Entries.Num() != Capacity)
+	{
+		Entries.SetNum(Capacity);
+	}
+
+	while (NumEntries > 0)
+	{
+		const FEntry& Oldest = Entries[OldestEntry];
+		const bool HasExpired = ExpiryTime > 0 && Oldest.TimeStamp + ExpiryTime < CurrentTime;
+
+		if (NumEntries < Capacity && Oldest.EventID.IsValid() && !HasExpired)
+		{
+			break;
+		}
+
+		RemoveOldest();
+	}
+
+	const int32 EntryIndex = (OldestEntry + NumEntries) % Capacity;
+	Entries[EntryIndex].EventID = EventID;
+	Entries[EntryIndex].TimeStamp = CurrentTime;
+	NumEntries++;
+
+	Slots.Add(EventID, EntryIndex);
+}
+
+void FHandledEventIDCache::RemoveOldest()
+{
+	FEntry& Oldest = Entries[OldestEntry];
+
+	if (Oldest.EventID.IsValid())
+	{
+		Slots.Remove(Oldest.EventID);
+		Oldest.EventID.Invalidate();
+		NumEvictions++;
+	}
+
+	OldestEntry = (OldestEntry + 1) % Capacity;
+	NumEntries--;
+}
@@ -367,6 +367,141 @@ struct TStructOpsTypeTraits<FStructAttributeContainer> : public TStructOpsTypeTr
 	};
 };
 
+/**
+ * Maps the tags of an attribute array to their index so attributes can be found without scanning the array.
+ * Lookups check that the attribute at the index still has the tag and rebuild the index if it doesn't, so an array
+ * that was changed without going through the index costs a rebuild instead of returning the wrong attribute.
+ * Arrays that are replaced wholesale should call Rebuild since a lookup can't tell a missing attribute from a stale index
+ * when the array still has the same number of attributes.
+ */
+struct FAttributeTagIndex
+{
+	template <typename AttributeType>
+	AttributeType* Find(TArray<AttributeType>& Attributes, const FGameplayTag& AttributeTag)
+	{
+		const int32 AttributeIndex = FindIndex(Attributes, AttributeTag);
+		return AttributeIndex != INDEX_NONE ? &Attributes[AttributeIndex] : nullptr;
+	}
+
+	/* Same as Find for const arrays. Still not const itself, as the lookup can rebuild the index. */
+	template <typename AttributeType>
+	const AttributeType* Find(const TArray<AttributeType>& Attributes, const FGameplayTag& AttributeTag)
+	{
+		const int32 AttributeIndex = FindIndex(Attributes, AttributeTag);
+		return AttributeIndex != INDEX_NONE ? &Attributes[AttributeIndex] : nullptr;
+	}
+
+	/* Returns the array index of the attribute with the tag or INDEX_NONE. */
+	template <typename AttributeType>
+	int32 FindIndex(const TArray<AttributeType>& Attributes, const FGameplayTag& AttributeTag)
+	{
+		if (const int32* AttributeIndex = Indices.Find(AttributeTag))
+		{
+			if (Attributes.IsValidIndex(*AttributeIndex) && Attributes[*AttributeIndex].AttributeTag == AttributeTag)
+			{
+				return *AttributeIndex;
+			}
+		}
+		else if (IndexedNum == Attributes.Num())
+		{
+			return INDEX_NONE;
+		}
+
+		Rebuild(Attributes);
+
+		const int32* AttributeIndex = Indices.Find(AttributeTag);
+		return AttributeIndex ? *AttributeIndex : INDEX_NONE;
+	}
+
+	/* Adds the attribute to the end of the array. Doesn't check whether the array already contains the attribute. */
+	template <typename AttributeType>
+	AttributeType& Add(TArray<AttributeType>& Attributes, const AttributeType& Attribute)
+	{
+		const int32 AttributeIndex = Attributes.Add(Attribute);
+		Indices.Add(Attribute.AttributeTag, AttributeIndex);
+		IndexedNum = Attributes.Num();
+		return Attributes[AttributeIndex];
+	}
+
+	/* Removes the attribute by swapping the last attribute into its place. Returns false if there was no such attribute. */
+	template <typename AttributeType>
+	bool Remove(TArray<AttributeType>& Attributes, const FGameplayTag& AttributeTag)
+	{
+		AttributeType* Attribute = Find(Attributes, AttributeTag);
+
+		if (!Attribute)
+		{
+			return false;
+		}
+
+		const int32 AttributeIndex = static_cast<int32>(Attribute - Attributes.GetData());
+		Indices.Remove(AttributeTag);
+		Attributes.RemoveAtSwap(AttributeIndex);
+
+		if (Attributes.IsValidIndex(AttributeIndex))
+		{
+			Indices.Add(Attributes[AttributeIndex].AttributeTag, AttributeIndex);
+		}
+
+		IndexedNum = Attributes.Num();
+		Generation = MakeGeneration();
+		return true;
+	}
+
+	template <typename AttributeType>
+	void Rebuild(const TArray<AttributeType>& Attributes)
+	{
+		Indices.Reset();
+
+		// Iterate backwards so the first attribute with a tag wins if there are duplicates, like it did when scanning the array
+		for (int32 AttributeIndex = Attributes.Num() - 1; AttributeIndex >= 0; --AttributeIndex)
+		{
+			Indices.Add(Attributes[AttributeIndex].AttributeTag, AttributeIndex);
+		}
+
+		IndexedNum = Attributes.Num();
+		Generation = MakeGeneration();
+	}
+
+	/**
+	 * Changes every time attributes move to a different index. Generations are unique across all indices, so a
+	 * generation taken from one index never matches another index.
+	 */
+	uint32 GetGeneration() const { return Generation; }
+
+private:
+	static SIMPLEGAMEPLAYABILITYSYSTEM_API uint32 MakeGeneration();
+
+	uint32 Generation = MakeGeneration();
+
+	TMap<FGameplayTag, int32> Indices;
+
+	// The size of the array when the index was last updated
+	int32 IndexedNum = 0;
+};
+
+/**
+ * A float attribute resolved with USimpleGameplayAbilityComponent::ResolveFloatAttribute. Remembers where the attribute
+ * is so using the handle again skips the tag lookup until attributes are added to or removed from the component.
+ */
+USTRUCT(BlueprintType)
+struct FSimpleFloatAttributeHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	FGameplayTag AttributeTag;
+
+	// Cached by the component that resolved the handle. Only used while Generation matches the component's attribute index.
+	int32 AttributeIndex = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsValid() const
+	{
+		return AttributeTag.IsValid();
+	}
+};
+
 USTRUCT(BlueprintType)
 struct FGameplayTagCounter : public FFastArraySerializerItem
 {
@@ -453,6 +588,153 @@ struct TStructOpsTypeTraits<FGameplayTagCounterContainer> : public TStructOpsTyp
 	};
 };
 
+/**
+ * A set of gameplay tags stored as one bit per tag, keyed by the tag's net index. Only the tags themselves are set,
+ * not their parents, so it can only answer exact queries.
+ * Net indices change when the gameplay tag tree is rebuilt (e.g. when tags are added in the editor), so the set
+ * remembers the net index hash it was built with and needs a Rebuild when it's no longer up to date.
+ */
+struct SIMPLEGAMEPLAYABILITYSYSTEM_API FGameplayTagBitSet
+{
+	/* Returns false if the tag has no net index. */
+	bool AddTag(const FGameplayTag& Tag);
+	void RemoveTag(const FGameplayTag& Tag);
+	void Rebuild(const FGameplayTagContainer& Tags);
+	bool IsUpToDate() const;
+
+	uint32 GetNetIndexHash() const { return NetIndexHash; }
+
+private:
+	friend struct FGameplayTagBitMask;
+
+	TArray<uint64> Words;
+	uint32 NetIndexHash = 0;
+};
+
+/**
+ * A tag container precomputed as the FGameplayTagBitSet words it needs to check, so checking it against a bit set
+ * only takes one AND and compare per word that has one of its tags. Masks are built from requirement containers
+ * that rarely change (e.g. on class default objects) and are checked many times.
+ */
+struct SIMPLEGAMEPLAYABILITYSYSTEM_API FGameplayTagBitMask
+{
+	FGameplayTagBitMask() = default;
+	explicit FGameplayTagBitMask(const FGameplayTagContainer& InTags);
+
+	/* True if the mask was built with the current net indices. */
+	bool IsUpToDate() const;
+
+	/* True if the mask can be checked against the bit set. If not, check GetTags() against a tag container instead. */
+	bool CanCheck(const FGameplayTagBitSet& BitSet) const
+	{
+		return CanUseBits && BitSet.NetIndexHash == NetIndexHash;
+	}
+
+	/* Same as FGameplayTagContainer::HasAllExact. An empty mask is in every bit set. */
+	bool IsAllIn(const FGameplayTagBitSet& BitSet) const;
+
+	/* Same as FGameplayTagContainer::HasAnyExact. An empty mask is in no bit set. */
+	bool IsAnyIn(const FGameplayTagBitSet& BitSet) const;
+
+	const FGameplayTagContainer& GetTags() const { return Tags; }
+
+private:
+	FGameplayTagContainer Tags;
+
+	// Only the words that have at least one of the tags
+	TArray<TPair<int32, uint64>, TInlineAllocator<2>> Words;
+
+	uint32 NetIndexHash = 0;
+
+	// False if one of the tags has no net index
+	bool CanUseBits = false;
+};
+
+/**
+ * Maps the tags of a gameplay tag counter array to their index and keeps a container of the counted tags, so exact
+ * lookups are a map lookup and hierarchical or container wide queries can use FGameplayTagContainer (which also
+ * keeps the parent tags of its tags).
+ * The counter array must only be changed through the index, or Rebuild must be called after changing it.
+ */
+struct FGameplayTagCounterIndex
+{
+	FGameplayTagCounter* Find(TArray<FGameplayTagCounter>& TagCounters, const FGameplayTag& Tag) const;
+
+	/* Adds a counter for a tag that isn't counted yet to the end of the array. */
+	FGameplayTagCounter& Add(TArray<FGameplayTagCounter>& TagCounters, const FGameplayTagCounter& TagCounter);
+
+	/* Removes the tag's counter by swapping the last counter into its place. Returns false if the tag wasn't counted. */
+	bool Remove(TArray<FGameplayTagCounter>& TagCounters, const FGameplayTag& Tag);
+
+	void Rebuild(const TArray<FGameplayTagCounter>& TagCounters);
+
+	/* The tags that have a counter. */
+	const FGameplayTagContainer& GetTags() const { return Tags; }
+
+	/* Starts or stops mirroring the counted tags into a bit set. */
+	void SetUseBitSet(bool UseBitSet);
+
+	/* The counted tags as a bit set, or nullptr if the index doesn't keep one. */
+	const FGameplayTagBitSet* GetBitSet() const { return UseBitSet ? &BitSet : nullptr; }
+
+private:
+	void AddToBitSet(const FGameplayTag& Tag);
+
+	TMap<FGameplayTag, int32> Indices;
+	FGameplayTagContainer Tags;
+
+	FGameplayTagBitSet BitSet;
+	bool UseBitSet = false;
+};
+
+/**
+ * Remembers the IDs of replicated events that were already handled so an event arriving a second time (e.g. a predicted
+ * event coming back from the server) isn't sent again. Holds at most Capacity IDs and forgets IDs after ExpiryTime
+ * seconds, oldest first, so it should be sized to cover the longest time an event can take to come back.
+ */
+struct SIMPLEGAMEPLAYABILITYSYSTEM_API FHandledEventIDCache
+{
+	void Initialize(int32 InCapacity, double InExpiryTime);
+
+	/* Returns true and forgets the ID if it was handled before, false if the event still needs to be handled. */
+	bool Consume(const FGuid& EventID, double CurrentTime);
+
+	void Add(const FGuid& EventID, double CurrentTime);
+
+	int32 Num() const { return Slots.Num(); }
+
+	// Counters since the cache was initialized, for tuning Capacity and ExpiryTime
+	uint64 GetNumHits() const { return NumHits; }
+	uint64 GetNumMisses() const { return NumMisses; }
+	// IDs forgotten before they were consumed, because they expired or the cache was full
+	uint64 GetNumEvictions() const { return NumEvictions; }
+
+private:
+	struct FEntry
+	{
+		FGuid EventID;
+		double TimeStamp = 0.0;
+	};
+
+	// Removes the oldest entry, counting it as an eviction if it wasn't consumed yet
+	void RemoveOldest();
+
+	// Ring buffer of the handled IDs in the order they were added. Consumed entries are left behind as invalid IDs.
+	TArray<FEntry> Entries;
+	int32 OldestEntry = 0;
+	int32 NumEntries = 0;
+
+	// Event ID to index in Entries
+	TMap<FGuid, int32> Slots;
+
+	int32 Capacity = 256;
+	double ExpiryTime = 10.0;
+
+	uint64 NumHits = 0;
+	uint64 NumMisses = 0;
+	uint64 NumEvictions = 0;
+};
+
 UENUM(BlueprintType)
 enum class EFlowControl : uint8
 {
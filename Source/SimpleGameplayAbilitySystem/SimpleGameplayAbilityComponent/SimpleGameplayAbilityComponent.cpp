@@ -16,6 +16,14 @@ class USimpleEventSubsystem;
 
 using enum EAbilityStatus;
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Handled Event ID Hits"), STAT_SimpleGAS_HandledEventIDHits, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Handled Event ID Misses"), STAT_SimpleGAS_HandledEventIDMisses, STATGROUP_SimpleGAS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Handled Event ID Evictions"), STAT_SimpleGAS_HandledEventIDEvictions, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ability Instances Reused"), STAT_SimpleGAS_AbilityInstancesReused, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ability Instances Created"), STAT_SimpleGAS_AbilityInstancesCreated, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Modifier Instances Reused"), STAT_SimpleGAS_ModifierInstancesReused, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Modifier Instances Created"), STAT_SimpleGAS_ModifierInstancesCreated, STATGROUP_SimpleGAS);
+
 USimpleGameplayAbilityComponent::USimpleGameplayAbilityComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -28,16 +36,16 @@ void USimpleGameplayAbilityComponent::BeginPlay()
 
 	SetIsReplicated(true);
 
+	HandledEventIDs.Initialize(HandledEventIDCacheSize, HandledEventIDExpiryTime);
+
 	// Listen for ability ended event (existing code)
 	if (USimpleEventSubsystem* EventSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>())
 	{
 		FGameplayTagContainer EventTags;
 		EventTags.AddTag(FDefaultTags::AbilityEnded());
     
-		FSimpleEventDelegate EventDelegate;
-		EventDelegate.BindDynamic(this, &USimpleGameplayAbilityComponent::OnAbilityEndedEventReceived);
-		
-		EventSubsystem->ListenForEvent(this, false, EventTags, {}, EventDelegate, {}, {});
+		EventSubsystem->ListenForEvent<FSimpleAbilityEndedEvent>(this, false, EventTags, {},
+			TSimpleEventDelegate<FSimpleAbilityEndedEvent>::CreateUObject(this, &USimpleGameplayAbilityComponent::OnAbilityEndedEventReceived));
 	}
 	
 	if (HasAuthority())
@@ -117,16 +125,23 @@ void USimpleGameplayAbilityComponent::BeginPlay()
 
 	LocalFloatAttributes = AuthorityFloatAttributes.Attributes;
 	LocalStructAttributes = AuthorityStructAttributes.Attributes;
+	LocalFloatAttributeIndex.Rebuild(LocalFloatAttributes);
+	LocalStructAttributeIndex.Rebuild(LocalStructAttributes);
 
 	LocalGameplayTags = AuthorityGameplayTags.Tags;
+	LocalGameplayTagIndex.Rebuild(LocalGameplayTags);
+	AuthorityGameplayTagIndex.SetUseBitSet(UseGameplayTagBitSet);
+	LocalGameplayTagIndex.SetUseBitSet(UseGameplayTagBitSet);
     LocalAbilityStates = AuthorityAbilityStates.AbilityStates;
+	LocalAbilityStateIndex.Rebuild(LocalAbilityStates);
     LocalAttributeStates = AuthorityAttributeStates.AbilityStates;
 }
 
 void USimpleGameplayAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Clean up attribute modifiers
-	for (USimpleAttributeModifier* AttributeModifier : InstancedAttributes)
+	// Clean up attribute modifiers, iterating a copy because ending a modifier releases it from InstancedAttributes
+	TArray<TObjectPtr<USimpleAttributeModifier>> AttributeModifiersToCleanUp = InstancedAttributes;
+	for (USimpleAttributeModifier* AttributeModifier : AttributeModifiersToCleanUp)
 	{
 		AttributeModifier->CleanUpAbility();
 	}
@@ -140,6 +155,12 @@ void USimpleGameplayAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlay
 	// Clear collections
 	InstancedAttributes.Empty();
 	InstancedAbilities.Empty();
+	SingleInstanceAbilitiesByClass.Empty();
+	InstancedAbilitiesByID.Empty();
+	InstancedAttributesByClass.Empty();
+	InstancedAttributesByID.Empty();
+	AbilityInstancePools.Empty();
+	AttributeModifierInstancePools.Empty();
     
 	// Unsubscribe from events
 	if (USimpleEventSubsystem* EventSubsystem = GetWorld() ? GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>() : nullptr)
@@ -301,33 +322,28 @@ void USimpleGameplayAbilityComponent::ServerActivateAbility_Implementation(const
 	ActivateAbilityInternal(AbilityID, AbilityClass, AbilityContext, ActivationPolicy, true, ActivationTime);
 }
 
-void USimpleGameplayAbilityComponent::OnAbilityEndedEventReceived(FGameplayTag EventTag, FGameplayTag Domain, FInstancedStruct Payload, UObject* Sender)
+void USimpleGameplayAbilityComponent::OnAbilityEndedEventReceived(FGameplayTag EventTag, FGameplayTag Domain, const FSimpleAbilityEndedEvent& EndedEvent, UObject* Sender)
 {
-	const FSimpleAbilityEndedEvent* EndedEvent = Payload.GetPtr<FSimpleAbilityEndedEvent>();
-
-	if (!EndedEvent)
-	{
-		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::OnAbilityEndedEventReceived]: Ability end event was sent with malformed payload. Payload was not of type FSimpleAbilityEndedEvent.")));
-		return;
-	}
-	
-	FAbilityState* AbilityState = GetAbilityState(EndedEvent->AbilityID, HasAuthority());
+	FAbilityState* AbilityState = GetAbilityState(EndedEvent.AbilityID, HasAuthority());
 
 	if (!AbilityState)
 	{
 		return;
 	}
 	
-	const EAbilityStatus StatusToSet = EndedEvent->WasCancelled ? EndedCancelled : EndedSuccessfully;
-	AbilityState->EndingContext = Payload;
+	const EAbilityStatus StatusToSet = EndedEvent.WasCancelled ? EndedCancelled : EndedSuccessfully;
+	AbilityState->EndingContext = FInstancedStruct::Make(EndedEvent);
 	AbilityState->AbilityStatus = StatusToSet;
+	AbilityState->EndedTimeStamp = GetServerTime();
 	
 	if (HasAuthority())
 	{
 		AuthorityAbilityStates.MarkItemDirty(*AbilityState);
 	}
 
-	OnAbilityEnded(EndedEvent->AbilityID, EndedEvent->EndStatusTag, EndedEvent->EndingContext, EndedEvent->WasCancelled);
+	OnAbilityEnded(EndedEvent.AbilityID, EndedEvent.EndStatusTag, EndedEvent.EndingContext, EndedEvent.WasCancelled);
+
+	PruneEndedAbilityStates();
 }
 
 void USimpleGameplayAbilityComponent::OnAbilityEnded_Implementation(FGuid AbilityID, FGameplayTag EndStatus, FInstancedStruct EndContext, bool WasCancelled)
@@ -351,28 +367,90 @@ FAbilityState& USimpleGameplayAbilityComponent::CreateAbilityState(
 	
 	if (IsAuthorityState)
 	{
-		AuthorityAbilityStates.AbilityStates.Add(NewAbilityState);
+		FAbilityState& AuthorityAbilityState = AuthorityAbilityStateIndex.Add(AuthorityAbilityStates.AbilityStates, NewAbilityState);
 		AuthorityAbilityStates.MarkArrayDirty();
-		return AuthorityAbilityStates.AbilityStates.Last();
+		return AuthorityAbilityState;
 	}
 
-	LocalAbilityStates.Add(NewAbilityState);
-	return LocalAbilityStates.Last();
+	return LocalAbilityStateIndex.Add(LocalAbilityStates, NewAbilityState);
 }
 
 FAbilityState* USimpleGameplayAbilityComponent::GetAbilityState(const FGuid AbilityID, const bool IsAuthorityState)
 {
-	TArray<FAbilityState>& AbilityStates = IsAuthorityState ? AuthorityAbilityStates.AbilityStates : LocalAbilityStates;
-	
-	for (FAbilityState& AbilityState : AbilityStates)
+	return IsAuthorityState
+		? AuthorityAbilityStateIndex.Find(AuthorityAbilityStates.AbilityStates, AbilityID)
+		: LocalAbilityStateIndex.Find(LocalAbilityStates, AbilityID);
+}
+
+void USimpleGameplayAbilityComponent::PruneEndedAbilityStates()
+{
+	if (EndedAbilityStateRetentionTime <= 0 && MaxEndedAbilityStates <= 0)
 	{
-		if (AbilityState.AbilityID == AbilityID)
+		return;
+	}
+
+	const bool IsAuthority = HasAuthority();
+	TArray<FAbilityState>& AbilityStates = IsAuthority ? AuthorityAbilityStates.AbilityStates : LocalAbilityStates;
+	FAbilityStateIndex& AbilityStateIndex = IsAuthority ? AuthorityAbilityStateIndex : LocalAbilityStateIndex;
+	const double ServerTime = GetServerTime();
+
+	TArray<FGuid> StatesToRemove;
+	TArray<TPair<double, FGuid>> KeptEndedStates;
+
+	for (const FAbilityState& AbilityState : AbilityStates)
+	{
+		if (AbilityState.AbilityStatus == PreActivation || AbilityState.AbilityStatus == ActivationSuccess)
+		{
+			continue;
+		}
+
+		// Clients only remove states the server doesn't replicate, replicated states are removed when the server removes them
+		if (!IsAuthority && AbilityState.ActivationPolicy != EAbilityActivationPolicy::LocalOnly && AbilityState.ActivationPolicy != EAbilityActivationPolicy::ClientOnly)
+		{
+			continue;
+		}
+
+		if (EndedAbilityStateRetentionTime > 0 && AbilityState.EndedTimeStamp + EndedAbilityStateRetentionTime <= ServerTime)
 		{
-			return &AbilityState;
+			StatesToRemove.Add(AbilityState.AbilityID);
+			continue;
 		}
+
+		KeptEndedStates.Emplace(AbilityState.EndedTimeStamp, AbilityState.AbilityID);
 	}
 
-	return nullptr;
+	KeptEndedStates.Sort([](const TPair<double, FGuid>& A, const TPair<double, FGuid>& B) { return A.Key < B.Key; });
+
+	if (MaxEndedAbilityStates > 0 && KeptEndedStates.Num() > MaxEndedAbilityStates)
+	{
+		const int32 NumOldestStates = KeptEndedStates.Num() - MaxEndedAbilityStates;
+
+		for (int32 i = 0; i < NumOldestStates; i++)
+		{
+			StatesToRemove.Add(KeptEndedStates[i].Value);
+		}
+
+		KeptEndedStates.RemoveAt(0, NumOldestStates);
+	}
+
+	for (const FGuid& AbilityID : StatesToRemove)
+	{
+		AbilityStateIndex.Remove(AbilityStates, AbilityID);
+	}
+
+	// Removed items replicate as removals to clients, which then remove their local copies in OnStateRemoved
+	if (IsAuthority && StatesToRemove.Num() > 0)
+	{
+		AuthorityAbilityStates.MarkArrayDirty();
+	}
+
+	// Check again when the oldest ended state we kept expires
+	if (EndedAbilityStateRetentionTime > 0 && KeptEndedStates.Num() > 0 && GetWorld())
+	{
+		const double TimeUntilExpired = KeptEndedStates[0].Key + EndedAbilityStateRetentionTime - ServerTime;
+		GetWorld()->GetTimerManager().SetTimer(EndedAbilityStatePruneTimerHandle, this, &USimpleGameplayAbilityComponent::PruneEndedAbilityStates,
+			FMath::Max(static_cast<float>(TimeUntilExpired), 0.1f), false);
+	}
 }
 
 USimpleAttributeHandler* USimpleGameplayAbilityComponent::GetAttributeHandler(const FGameplayTag& AttributeTag)
@@ -434,14 +512,34 @@ bool USimpleGameplayAbilityComponent::SetAbilityStatus(const FGuid AbilityID, co
 
 USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetAbilityInstance(TSubclassOf<USimpleGameplayAbility> AbilityClass)
 {
-	if (AbilityClass.GetDefaultObject()->InstancingPolicy == EAbilityInstancingPolicy::SingleInstance)
+	const USimpleGameplayAbility* AbilityCDO = AbilityClass.GetDefaultObject();
+	const bool IsSingleInstance = AbilityCDO->InstancingPolicy == EAbilityInstancingPolicy::SingleInstance;
+
+	// Check if we already have an instance of the ability created
+	if (IsSingleInstance)
+	{
+		if (const TObjectPtr<USimpleGameplayAbility>* InstancedAbility = SingleInstanceAbilitiesByClass.Find(AbilityClass))
+		{
+			return *InstancedAbility;
+		}
+	}
+	// Reuse an ended instance if this ability class allows pooling
+	else if (AbilityCDO->AllowInstancePooling)
 	{
-		// Check if we already have an instance of the ability created
-		for (USimpleGameplayAbility* InstancedAbility : InstancedAbilities)
+		if (FAbilityInstancePool* Pool = AbilityInstancePools.Find(AbilityClass))
 		{
-			if (InstancedAbility->GetClass() == AbilityClass)
+			while (Pool->Instances.Num() > 0)
 			{
-				return InstancedAbility;
+				USimpleGameplayAbility* PooledInstance = Pool->Instances.Pop();
+				if (!IsValid(PooledInstance))
+				{
+					continue;
+				}
+
+				PooledInstance->ResetAbility();
+				InstancedAbilities.Add(PooledInstance);
+				INC_DWORD_STAT(STAT_SimpleGAS_AbilityInstancesReused);
+				return PooledInstance;
 			}
 		}
 	}
@@ -449,8 +547,14 @@ USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetAbilityInstance(TSub
 	// If we don't have an instance of the ability created (or a MultipleInstance policy) we create one
 	USimpleGameplayAbility* NewAbilityInstance = NewObject<USimpleGameplayAbility>(this, AbilityClass);
 	InstancedAbilities.Add(NewAbilityInstance);
+	INC_DWORD_STAT(STAT_SimpleGAS_AbilityInstancesCreated);
+
+	if (IsSingleInstance)
+	{
+		SingleInstanceAbilitiesByClass.Add(AbilityClass, NewAbilityInstance);
+	}
 	
-	return InstancedAbilities.Last();	
+	return NewAbilityInstance;	
 }
 
 bool USimpleGameplayAbilityComponent::CancelAbility(const FGuid AbilityInstanceID, const FInstancedStruct CancellationContext, const bool ForceCancel)
@@ -540,31 +644,94 @@ void USimpleGameplayAbilityComponent::RemoveAbilityOverride(TSubclassOf<USimpleG
 
 void USimpleGameplayAbilityComponent::AddAbilityStateSnapshot(FGuid AbilityInstanceID, FSimpleAbilitySnapshot State)
 {
-	if (HasAuthority())
+	if (FAbilityState* AbilityState = GetAbilityState(AbilityInstanceID, HasAuthority()))
 	{
-		for (FAbilityState& AuthorityAbilityState : AuthorityAbilityStates.AbilityStates)
+		AddSnapshotToHistory(*AbilityState, State);
+
+		if (HasAuthority())
 		{
-			if (AuthorityAbilityState.AbilityID == AbilityInstanceID)
-			{
-				AuthorityAbilityState.SnapshotHistory.Add(State);
-				AuthorityAbilityStates.MarkItemDirty(AuthorityAbilityState);
-				return;
-			}
-		}	
+			AuthorityAbilityStates.MarkItemDirty(*AbilityState);
+		}
+
+		return;
 	}
-	else
+
+	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::AddAbilityStateSnapshot]: Ability with ID %s not found in InstancedAbilities array"), *AbilityInstanceID.ToString()));
+}
+
+void USimpleGameplayAbilityComponent::ServerAcknowledgeSnapshot_Implementation(FGuid AbilityInstanceID, int32 SequenceNumber)
+{
+	FAbilityState* AbilityState = GetAbilityState(AbilityInstanceID, true);
+
+	if (!AbilityState)
 	{
-		for (FAbilityState& ActiveAbility : LocalAbilityStates)
+		AbilityState = AuthorityAttributeStates.AbilityStates.FindByPredicate([AbilityInstanceID](const FAbilityState& AttributeState)
 		{
-			if (ActiveAbility.AbilityID == AbilityInstanceID)
-			{
-				ActiveAbility.SnapshotHistory.Add(State);
-				return;
-			}
-		}	
+			return AttributeState.AbilityID == AbilityInstanceID;
+		});
 	}
 
-	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::AddAbilityStateSnapshot]: Ability with ID %s not found in InstancedAbilities array"), *AbilityInstanceID.ToString()));
+	// The state may already have been removed, acknowledgements are unreliable and can arrive late
+	if (!AbilityState)
+	{
+		return;
+	}
+
+	// Snapshots are in the order they were taken. The latest snapshot is always kept because clients that receive the
+	// state for the first time fast forward to it.
+	TArray<FSimpleAbilitySnapshot>& SnapshotHistory = AbilityState->SnapshotHistory;
+	int32 NumAcknowledged = 0;
+
+	while (NumAcknowledged < SnapshotHistory.Num() - 1 && SnapshotHistory[NumAcknowledged].SequenceNumber <= SequenceNumber)
+	{
+		NumAcknowledged++;
+	}
+
+	// Not marked dirty, the client already has these snapshots. The shorter history is sent with the next change.
+	SnapshotHistory.RemoveAt(0, NumAcknowledged);
+}
+
+void USimpleGameplayAbilityComponent::AddSnapshotToHistory(FAbilityState& AbilityState, const FSimpleAbilitySnapshot& Snapshot)
+{
+	AbilityState.SnapshotHistory.Add(Snapshot);
+
+	const int32 MaxSnapshotHistory = AbilityState.AbilityClass ? FMath::Max(AbilityState.AbilityClass.GetDefaultObject()->MaxSnapshotHistory, 1) : 1;
+	const int32 NumOldSnapshots = AbilityState.SnapshotHistory.Num() - MaxSnapshotHistory;
+
+	if (NumOldSnapshots <= 0)
+	{
+		return;
+	}
+
+	// Clients that missed trimmed snapshots fast forward to the latest one
+	if (HasAuthority())
+	{
+		AbilityState.SnapshotHistory.RemoveAt(0, NumOldSnapshots);
+		return;
+	}
+
+	// A client's unresolved snapshots are still waiting for the server's version, so only the oldest resolved ones are
+	// dropped and the history can grow past MaxSnapshotHistory until they're resolved
+	int32 NumSnapshotsToRemove = NumOldSnapshots;
+	AbilityState.SnapshotHistory.RemoveAll([&NumSnapshotsToRemove](const FSimpleAbilitySnapshot& LocalSnapshot)
+	{
+		if (NumSnapshotsToRemove > 0 && LocalSnapshot.WasClientSnapshotResolved)
+		{
+			NumSnapshotsToRemove--;
+			return true;
+		}
+
+		return false;
+	});
+}
+
+void USimpleGameplayAbilityComponent::AcknowledgeSnapshot(FGuid AbilityInstanceID, int32 SequenceNumber)
+{
+	// Only the owning client can send server RPCs
+	if (GetOwner() && GetOwner()->GetNetConnection())
+	{
+		ServerAcknowledgeSnapshot(AbilityInstanceID, SequenceNumber);
+	}
 }
 
 /* Tag Functions */
@@ -572,7 +739,8 @@ void USimpleGameplayAbilityComponent::AddAbilityStateSnapshot(FGuid AbilityInsta
 void USimpleGameplayAbilityComponent::AddGameplayTag(FGameplayTag Tag, FInstancedStruct Payload)
 {
 	TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
-	FGameplayTagCounter* TagCounter = TagCounters.FindByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); });
+	FGameplayTagCounterIndex& TagIndex = HasAuthority() ? AuthorityGameplayTagIndex : LocalGameplayTagIndex;
+	FGameplayTagCounter* TagCounter = TagIndex.Find(TagCounters, Tag);
 
 	if (TagCounter)
 	{
@@ -590,7 +758,7 @@ void USimpleGameplayAbilityComponent::AddGameplayTag(FGameplayTag Tag, FInstance
 	NewTagCounter.GameplayTag = Tag;
 	NewTagCounter.ReferenceCounter = 1;
 	
-	TagCounters.AddUnique(NewTagCounter);
+	TagIndex.Add(TagCounters, NewTagCounter);
 
 	if (HasAuthority())
 	{
@@ -603,9 +771,15 @@ void USimpleGameplayAbilityComponent::AddGameplayTag(FGameplayTag Tag, FInstance
 void USimpleGameplayAbilityComponent::RemoveGameplayTag(FGameplayTag Tag, FInstancedStruct Payload)
 {
 	TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
-	FGameplayTagCounter* TagCounter = TagCounters.FindByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); });
+	FGameplayTagCounterIndex& TagIndex = HasAuthority() ? AuthorityGameplayTagIndex : LocalGameplayTagIndex;
+	FGameplayTagCounter* TagCounter = TagIndex.Find(TagCounters, Tag);
+
+	if (!TagCounter)
+	{
+		return;
+	}
 
-	if (TagCounter && TagCounter->ReferenceCounter > 1)
+	if (TagCounter->ReferenceCounter > 1)
 	{
 		TagCounter->ReferenceCounter--;
 		
@@ -617,7 +791,7 @@ void USimpleGameplayAbilityComponent::RemoveGameplayTag(FGameplayTag Tag, FInsta
 		return;
 	}
 
-	TagCounters.RemoveSingle(*TagCounter);
+	TagIndex.Remove(TagCounters, Tag);
 
 	if (HasAuthority())
 	{
@@ -627,49 +801,59 @@ void USimpleGameplayAbilityComponent::RemoveGameplayTag(FGameplayTag Tag, FInsta
 	SendEvent(FDefaultTags::GameplayTagRemoved(), Tag, Payload, this, {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
-bool USimpleGameplayAbilityComponent::HasGameplayTag(FGameplayTag Tag) const
+bool USimpleGameplayAbilityComponent::HasGameplayTag(FGameplayTag Tag, bool OnlyMatchExact) const
+{
+	return OnlyMatchExact ? GetGameplayTags().HasTagExact(Tag) : GetGameplayTags().HasTag(Tag);
+}
+
+bool USimpleGameplayAbilityComponent::HasAllGameplayTags(FGameplayTagContainer Tags, bool OnlyMatchExact) const
+{
+	return OnlyMatchExact ? GetGameplayTags().HasAllExact(Tags) : GetGameplayTags().HasAll(Tags);
+}
+
+bool USimpleGameplayAbilityComponent::HasAnyGameplayTags(FGameplayTagContainer Tags, bool OnlyMatchExact) const
 {
-	const TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
+	return OnlyMatchExact ? GetGameplayTags().HasAnyExact(Tags) : GetGameplayTags().HasAny(Tags);
+}
 
-	return TagCounters.ContainsByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); });
+const FGameplayTagContainer& USimpleGameplayAbilityComponent::GetGameplayTags() const
+{
+	return HasAuthority() ? AuthorityGameplayTagIndex.GetTags() : LocalGameplayTagIndex.GetTags();
 }
 
-bool USimpleGameplayAbilityComponent::HasAllGameplayTags(FGameplayTagContainer Tags) const
+bool USimpleGameplayAbilityComponent::HasAllGameplayTags(const FGameplayTagBitMask& TagMask) const
 {
-	const TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
+	const FGameplayTagCounterIndex& TagIndex = HasAuthority() ? AuthorityGameplayTagIndex : LocalGameplayTagIndex;
+	const FGameplayTagBitSet* TagBitSet = TagIndex.GetBitSet();
 
-	for (const FGameplayTag& Tag : Tags)
+	if (TagBitSet && TagMask.CanCheck(*TagBitSet))
 	{
-		if (!TagCounters.ContainsByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); }))
-		{
-			return false;
-		}
+		return TagMask.IsAllIn(*TagBitSet);
 	}
 
-	return true;
+	return TagIndex.GetTags().HasAllExact(TagMask.GetTags());
 }
 
-bool USimpleGameplayAbilityComponent::HasAnyGameplayTags(FGameplayTagContainer Tags) const
+bool USimpleGameplayAbilityComponent::HasAnyGameplayTags(const FGameplayTagBitMask& TagMask) const
 {
-	const TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
+	const FGameplayTagCounterIndex& TagIndex = HasAuthority() ? AuthorityGameplayTagIndex : LocalGameplayTagIndex;
+	const FGameplayTagBitSet* TagBitSet = TagIndex.GetBitSet();
 
-	for (const FGameplayTag& Tag : Tags)
+	if (TagBitSet && TagMask.CanCheck(*TagBitSet))
 	{
-		if (TagCounters.ContainsByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); }))
-		{
-			return true;
-		}
+		return TagMask.IsAnyIn(*TagBitSet);
 	}
 
-	return false;
+	return TagIndex.GetTags().HasAnyExact(TagMask.GetTags());
 }
 
 /* Event Functions */
 
-void USimpleGameplayAbilityComponent::SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
-                                                UObject* Sender, TArray<UObject*> ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy)
+void USimpleGameplayAbilityComponent::SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload,
+                                                UObject* Sender, const TArray<UObject*>& ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy)
 {
-	const FGuid EventID = FGuid::NewGuid();
+	// The event ID is only used to avoid handling replicated events twice so non replicated events don't need one
+	const FGuid EventID = ReplicationPolicy == ESimpleEventReplicationPolicy::NoReplication ? FGuid() : FGuid::NewGuid();
 
 	switch (ReplicationPolicy)
 	{
@@ -742,21 +926,29 @@ void USimpleGameplayAbilityComponent::SendEventInternal(FGuid EventID, FGameplay
 		return;
 	}
 	
-	if (HandledEventIDs.Contains(EventID))
+	// No need to keep track of handled events if we're not replicating
+	if (ReplicationPolicy == ESimpleEventReplicationPolicy::NoReplication)
 	{
-		HandledEventIDs.Remove(EventID);
+		// Events sent through an ability component only reach listeners in the component's world
+		EventSubsystem->DispatchEvent(EventTag, DomainTag, Payload, Sender, ListenerFilter, GetWorld());
 		return;
 	}
+	
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const uint64 NumEvictions = HandledEventIDs.GetNumEvictions();
 
-	EventSubsystem->SendEvent(EventTag, DomainTag, Payload, Sender, ListenerFilter);
-
-	// No need to keep track of handled events if we're not replicating
-	if (ReplicationPolicy == ESimpleEventReplicationPolicy::NoReplication)
+	if (HandledEventIDs.Consume(EventID, CurrentTime))
 	{
+		INC_DWORD_STAT(STAT_SimpleGAS_HandledEventIDHits);
 		return;
 	}
+
+	INC_DWORD_STAT(STAT_SimpleGAS_HandledEventIDMisses);
+
+	EventSubsystem->DispatchEvent(EventTag, DomainTag, Payload, Sender, ListenerFilter, GetWorld());
 	
-	HandledEventIDs.Add(EventID);
+	HandledEventIDs.Add(EventID, CurrentTime);
+	INC_DWORD_STAT_BY(STAT_SimpleGAS_HandledEventIDEvictions, HandledEventIDs.GetNumEvictions() - NumEvictions);
 }
 
 void USimpleGameplayAbilityComponent::ServerSendEvent_Implementation(
@@ -811,16 +1003,67 @@ void USimpleGameplayAbilityComponent::MulticastSendEvent_Implementation(FGuid Ev
 void USimpleGameplayAbilityComponent::RemoveInstancedAbility(USimpleGameplayAbility* AbilityToRemove)
 {
 	InstancedAbilities.Remove(AbilityToRemove);
+
+	if (!AbilityToRemove)
+	{
+		return;
+	}
+
+	if (const TObjectPtr<USimpleGameplayAbility>* InstancedAbility = InstancedAbilitiesByID.Find(AbilityToRemove->AbilityInstanceID); InstancedAbility && *InstancedAbility == AbilityToRemove)
+	{
+		InstancedAbilitiesByID.Remove(AbilityToRemove->AbilityInstanceID);
+	}
+
+	if (const TObjectPtr<USimpleGameplayAbility>* InstancedAbility = SingleInstanceAbilitiesByClass.Find(AbilityToRemove->GetClass()); InstancedAbility && *InstancedAbility == AbilityToRemove)
+	{
+		SingleInstanceAbilitiesByClass.Remove(AbilityToRemove->GetClass());
+	}
+
+	// Keep the instance around for the next activation instead of letting it be garbage collected
+	if (AbilityToRemove->InstancingPolicy == EAbilityInstancingPolicy::MultipleInstances && AbilityToRemove->AllowInstancePooling)
+	{
+		FAbilityInstancePool& Pool = AbilityInstancePools.FindOrAdd(AbilityToRemove->GetClass());
+		if (Pool.Instances.Num() < MaxPooledAbilityInstances && !Pool.Instances.Contains(AbilityToRemove))
+		{
+			// A pooled instance shouldn't react to anything until it's reused
+			AbilityToRemove->ClearPendingCallbacks();
+			Pool.Instances.Add(AbilityToRemove);
+		}
+	}
 }
 
-USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetGameplayAbilityInstance(FGuid AbilityInstanceID)
+void USimpleGameplayAbilityComponent::UpdateInstanceID(USimpleAbilityBase* Instance, FGuid OldInstanceID)
 {
-	for (USimpleGameplayAbility* InstancedAbility : InstancedAbilities)
+	if (USimpleGameplayAbility* Ability = Cast<USimpleGameplayAbility>(Instance))
 	{
-		if (InstancedAbility->AbilityInstanceID == AbilityInstanceID)
+		if (const TObjectPtr<USimpleGameplayAbility>* InstancedAbility = InstancedAbilitiesByID.Find(OldInstanceID); InstancedAbility && *InstancedAbility == Ability)
 		{
-			return InstancedAbility;
+			InstancedAbilitiesByID.Remove(OldInstanceID);
 		}
+
+		InstancedAbilitiesByID.Add(Ability->AbilityInstanceID, Ability);
+		return;
+	}
+
+	if (USimpleAttributeModifier* Modifier = Cast<USimpleAttributeModifier>(Instance))
+	{
+		if (const TObjectPtr<USimpleAttributeModifier>* InstancedModifier = InstancedAttributesByID.Find(OldInstanceID); InstancedModifier && *InstancedModifier == Modifier)
+		{
+			InstancedAttributesByID.Remove(OldInstanceID);
+		}
+
+		InstancedAttributesByID.Add(Modifier->AbilityInstanceID, Modifier);
+	}
+}
+
+USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetGameplayAbilityInstance(FGuid AbilityInstanceID)
+{
+	const TObjectPtr<USimpleGameplayAbility>* InstancedAbility = InstancedAbilitiesByID.Find(AbilityInstanceID);
+
+	// Instances only map to the ID they had when they were last initialized, so this catches IDs that changed some other way
+	if (InstancedAbility && *InstancedAbility && (*InstancedAbility)->AbilityInstanceID == AbilityInstanceID)
+	{
+		return *InstancedAbility;
 	}
 	
 	return nullptr;
@@ -828,15 +1071,123 @@ USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetGameplayAbilityInsta
 
 USimpleAttributeModifier* USimpleGameplayAbilityComponent::GetAttributeModifierInstance(FGuid AttributeInstanceID)
 {
-	for (USimpleAttributeModifier* InstancedModifier : InstancedAttributes)
+	const TObjectPtr<USimpleAttributeModifier>* InstancedModifier = InstancedAttributesByID.Find(AttributeInstanceID);
+
+	if (InstancedModifier && *InstancedModifier && (*InstancedModifier)->AbilityInstanceID == AttributeInstanceID)
+	{
+		return *InstancedModifier;
+	}
+
+	return nullptr;
+}
+
+void USimpleGameplayAbilityComponent::AddAttributeModifierInstance(USimpleAttributeModifier* Modifier)
+{
+	InstancedAttributes.Add(Modifier);
+
+	// ApplyAttributeModifierToTarget replaces this with the instance it applies, so stacking finds the active one
+	TObjectPtr<USimpleAttributeModifier>& ClassInstance = InstancedAttributesByClass.FindOrAdd(Modifier->GetClass());
+
+	if (!ClassInstance)
+	{
+		ClassInstance = Modifier;
+	}
+}
+
+USimpleAttributeModifier* USimpleGameplayAbilityComponent::AcquireAttributeModifierInstance(const TSubclassOf<USimpleAttributeModifier> ModifierClass)
+{
+	if (FAttributeModifierInstancePool* Pool = AttributeModifierInstancePools.Find(ModifierClass))
 	{
-		if (InstancedModifier->AbilityInstanceID == AttributeInstanceID)
+		while (Pool->Instances.Num() > 0)
 		{
-			return InstancedModifier;
+			USimpleAttributeModifier* PooledModifier = Pool->Instances.Pop();
+			if (!IsValid(PooledModifier))
+			{
+				continue;
+			}
+
+			PooledModifier->ResetAbility();
+			AddAttributeModifierInstance(PooledModifier);
+			INC_DWORD_STAT(STAT_SimpleGAS_ModifierInstancesReused);
+			return PooledModifier;
 		}
 	}
 
-	return nullptr;
+	// Without a pooled instance we reuse the class' ended instance, which is still in InstancedAttributes
+	if (const TObjectPtr<USimpleAttributeModifier>* ClassInstance = InstancedAttributesByClass.Find(ModifierClass))
+	{
+		USimpleAttributeModifier* EndedModifier = *ClassInstance;
+
+		if (IsValid(EndedModifier) && !EndedModifier->IsModifierActive() && GetAttributeModifierInstance(EndedModifier->AbilityInstanceID) != EndedModifier)
+		{
+			EndedModifier->ResetAbility();
+			INC_DWORD_STAT(STAT_SimpleGAS_ModifierInstancesReused);
+			return EndedModifier;
+		}
+	}
+
+	USimpleAttributeModifier* NewModifier = NewObject<USimpleAttributeModifier>(this, ModifierClass);
+	AddAttributeModifierInstance(NewModifier);
+	INC_DWORD_STAT(STAT_SimpleGAS_ModifierInstancesCreated);
+	return NewModifier;
+}
+
+USimpleAttributeModifier* USimpleGameplayAbilityComponent::AcquireAttributeModifierProxy(const FAbilityState& AuthorityAttributeState)
+{
+	if (USimpleAttributeModifier* Modifier = GetAttributeModifierInstance(AuthorityAttributeState.AbilityID))
+	{
+		return Modifier;
+	}
+
+	const TSubclassOf<USimpleAttributeModifier> ModifierClass = Cast<UClass>(AuthorityAttributeState.AbilityClass.Get());
+	USimpleAttributeModifier* Modifier = AcquireAttributeModifierInstance(ModifierClass);
+	Modifier->InitializeAbility(this, AuthorityAttributeState.AbilityID, true);
+	return Modifier;
+}
+
+void USimpleGameplayAbilityComponent::ReleaseAttributeModifierInstance(USimpleAttributeModifier* Modifier)
+{
+	if (!Modifier || Modifier->IsModifierActive())
+	{
+		return;
+	}
+
+	if (const TObjectPtr<USimpleAttributeModifier>* InstancedModifier = InstancedAttributesByID.Find(Modifier->AbilityInstanceID); InstancedModifier && *InstancedModifier == Modifier)
+	{
+		InstancedAttributesByID.Remove(Modifier->AbilityInstanceID);
+	}
+
+	FAttributeModifierInstancePool& Pool = AttributeModifierInstancePools.FindOrAdd(Modifier->GetClass());
+
+	if (Pool.Instances.Contains(Modifier))
+	{
+		return;
+	}
+
+	Modifier->ClearPendingCallbacks();
+	const TObjectPtr<USimpleAttributeModifier>* ClassInstance = InstancedAttributesByClass.Find(Modifier->GetClass());
+
+	if (Pool.Instances.Num() < MaxPooledAttributeModifierInstances)
+	{
+		InstancedAttributes.Remove(Modifier);
+		Pool.Instances.Add(Modifier);
+
+		if (ClassInstance && *ClassInstance == Modifier)
+		{
+			InstancedAttributesByClass.Remove(Modifier->GetClass());
+		}
+
+		return;
+	}
+
+	// With the pool full or disabled the class keeps one ended instance for its next application, as it did before pooling
+	if (!ClassInstance || !*ClassInstance || *ClassInstance == Modifier)
+	{
+		InstancedAttributesByClass.Add(Modifier->GetClass(), Modifier);
+		return;
+	}
+
+	InstancedAttributes.Remove(Modifier);
 }
 
 TArray<FSimpleAbilitySnapshot>* USimpleGameplayAbilityComponent::GetLocalAttributeStateSnapshots(const FGuid AttributeInstanceID)
@@ -929,20 +1280,13 @@ void USimpleGameplayAbilityComponent::OnStateAdded(const FAbilityState& NewAbili
 		return;
 	}
 	
-	// A mapping of the local ability states for quick lookups
-	TMap<FGuid, int32> LocalStateArrayIndexMap;
-
 	// Added a new gameplay ability state
 	if (NewAbilityState.AbilityClass->IsChildOf(USimpleGameplayAbility::StaticClass()))
 	{
-		// Get a mapping of the local ability states for quick lookups
-		for (int32 i = 0; i < LocalAbilityStates.Num(); i++)
-		{
-			LocalStateArrayIndexMap.Add(LocalAbilityStates[i].AbilityID, i);
-		}
+		FAbilityState* LocalState = LocalAbilityStateIndex.Find(LocalAbilityStates, NewAbilityState.AbilityID);
 	
 		// If the NewAbilityState doesn't exist locally, we activate it
-		if (!LocalStateArrayIndexMap.Contains(NewAbilityState.AbilityID))
+		if (!LocalState)
 		{
 			if (NewAbilityState.ActivationPolicy == EAbilityActivationPolicy::ServerOnly)
 			{
@@ -951,8 +1295,7 @@ void USimpleGameplayAbilityComponent::OnStateAdded(const FAbilityState& NewAbili
 			
 			const TSubclassOf<USimpleGameplayAbility> AbilityClass = static_cast<TSubclassOf<USimpleGameplayAbility>>(NewAbilityState.AbilityClass);
 
-			LocalAbilityStates.AddUnique(NewAbilityState);
-			LocalStateArrayIndexMap.Add(NewAbilityState.AbilityID, LocalAbilityStates.Num() - 1);
+			LocalAbilityStateIndex.Add(LocalAbilityStates, NewAbilityState);
 
 			if (NewAbilityState.AbilityStatus != ActivationSuccess && NewAbilityState.AbilityStatus != EndedSuccessfully)
 			{
@@ -971,13 +1314,15 @@ void USimpleGameplayAbilityComponent::OnStateAdded(const FAbilityState& NewAbili
 			return;
 		}
 
-		FAbilityState& LocalState = LocalAbilityStates[LocalStateArrayIndexMap[NewAbilityState.AbilityID]];
-		CompareSnapshots(NewAbilityState, LocalState);
+		CompareSnapshots(NewAbilityState, *LocalState);
 	}
 
 	// Added a new attribute state
 	if (NewAbilityState.AbilityClass->IsChildOf(USimpleAttributeModifier::StaticClass()))
 	{
+		// A mapping of the local attribute states for quick lookups
+		TMap<FGuid, int32> LocalStateArrayIndexMap;
+
 		for (int32 i = 0; i < LocalAttributeStates.Num(); i++)
 		{
 			LocalStateArrayIndexMap.Add(LocalAttributeStates[i].AbilityID, i);
@@ -988,26 +1333,13 @@ void USimpleGameplayAbilityComponent::OnStateAdded(const FAbilityState& NewAbili
 		{
 			LocalAttributeStates.Add(NewAbilityState);
 
-			if (NewAbilityState.SnapshotHistory.Num() > 0)
+			// Client predicted modifiers already ran locally, their snapshots are resolved by OnStateChanged
+			if (NewAbilityState.SnapshotHistory.Num() > 0 &&
+				NewAbilityState.AbilityClass->GetDefaultObject<USimpleAttributeModifier>()->ModifierApplicationPolicy != EAttributeModifierApplicationPolicy::ApplyClientPredicted)
 			{
-				USimpleAttributeModifier* Modifier = GetAttributeModifierInstance(NewAbilityState.AbilityID);
-
-				if (!Modifier)
-				{
-					UClass* ParentClassPtr = NewAbilityState.AbilityClass.Get();
-					const TSubclassOf<USimpleAttributeModifier> AbilityClass = Cast<UClass>(ParentClassPtr);
-					Modifier = NewObject<USimpleAttributeModifier>(this, AbilityClass);
-					InstancedAttributes.Add(Modifier);
-				}
-
-				Modifier->InitializeAbility(this, NewAbilityState.AbilityID, true);
-
-				if (Modifier->ModifierApplicationPolicy == EAttributeModifierApplicationPolicy::ApplyClientPredicted)
-				{
-					return;
-				}
-				
+				USimpleAttributeModifier* Modifier = AcquireAttributeModifierProxy(NewAbilityState);
 				Modifier->ClientFastForwardState(NewAbilityState.SnapshotHistory.Last().SnapshotTag, NewAbilityState.SnapshotHistory.Last());
+				ReleaseAttributeModifierInstance(Modifier);
 			}
 		}
 		
@@ -1031,10 +1363,7 @@ void USimpleGameplayAbilityComponent::OnStateChanged(const FAbilityState& Author
 	if (AuthorityAbilityState.AbilityClass->IsChildOf(USimpleGameplayAbility::StaticClass()))
 	{
 		// Get a reference to the local version of the changed ability on the server
-		FAbilityState* LocalAbilityState = LocalAbilityStates.FindByPredicate([AuthorityAbilityState](const FAbilityState& AbilityState)
-		{
-			return AbilityState.AbilityID == AuthorityAbilityState.AbilityID;
-		});
+		FAbilityState* LocalAbilityState = LocalAbilityStateIndex.Find(LocalAbilityStates, AuthorityAbilityState.AbilityID);
 
 		// If the ability doesn't exist locally, we don't need to do anything
 		// Unless the ability we got from the server is still running
@@ -1053,7 +1382,7 @@ void USimpleGameplayAbilityComponent::OnStateChanged(const FAbilityState& Author
 			
 			const TSubclassOf<USimpleGameplayAbility> AbilityClass = static_cast<TSubclassOf<USimpleGameplayAbility>>(AuthorityAbilityState.AbilityClass);
 
-			LocalAbilityStates.AddUnique(AuthorityAbilityState);
+			LocalAbilityStateIndex.Add(LocalAbilityStates, AuthorityAbilityState);
 			USimpleGameplayAbility* NewAbilityInstance = GetAbilityInstance(AbilityClass);
 
 			if (NewAbilityInstance->IsAbilityActive())
@@ -1084,13 +1413,6 @@ void USimpleGameplayAbilityComponent::OnStateChanged(const FAbilityState& Author
 	{
 		if (AuthorityAbilityState.SnapshotHistory.Num() > 0)
 		{
-			USimpleAttributeModifier* Modifier = GetAttributeModifierInstance(AuthorityAbilityState.AbilityID);
-
-			if (!Modifier)
-			{
-				return;
-			}
-
 			TArray<FSimpleAbilitySnapshot>* LocalSnapshots = GetLocalAttributeStateSnapshots(AuthorityAbilityState.AbilityID);
 
 			if (!LocalSnapshots)
@@ -1098,6 +1420,8 @@ void USimpleGameplayAbilityComponent::OnStateChanged(const FAbilityState& Author
 				SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::OnStateChanged]: Attribute modifier with ID %s not found in LocalAttributeStates array"), *AuthorityAbilityState.AbilityID.ToString()));
 				return;
 			}
+
+			USimpleAttributeModifier* Modifier = AcquireAttributeModifierProxy(AuthorityAbilityState);
 			
 			for (FSimpleAbilitySnapshot& LocalSnapshot : *LocalSnapshots)
 			{
@@ -1105,9 +1429,12 @@ void USimpleGameplayAbilityComponent::OnStateChanged(const FAbilityState& Author
 				{
 					Modifier->ClientResolvePastState(AuthorityAbilityState.SnapshotHistory.Last().SnapshotTag, AuthorityAbilityState.SnapshotHistory.Last(), LocalSnapshot);
 					LocalSnapshot.WasClientSnapshotResolved = true;
+					AcknowledgeSnapshot(AuthorityAbilityState.AbilityID, AuthorityAbilityState.SnapshotHistory.Last().SequenceNumber);
 					break;
 				}
 			}
+
+			ReleaseAttributeModifierInstance(Modifier);
 		}	
 	}
 }
@@ -1116,13 +1443,16 @@ void USimpleGameplayAbilityComponent::OnStateRemoved(const FAbilityState& Remove
 {
 	if (RemovedAbilityState.AbilityClass->IsChildOf(USimpleGameplayAbility::StaticClass()))
 	{
-		LocalAbilityStates.RemoveAll([RemovedAbilityState](const FAbilityState& AbilityState) { return AbilityState.AbilityID == RemovedAbilityState.AbilityID; });
+		LocalAbilityStateIndex.Remove(LocalAbilityStates, RemovedAbilityState.AbilityID);
 		return;
 	}
 
 	if (RemovedAbilityState.AbilityClass->IsChildOf(USimpleAttributeModifier::StaticClass()))
 	{
 		LocalAttributeStates.RemoveAll([RemovedAbilityState](const FAbilityState& AbilityState) { return AbilityState.AbilityID == RemovedAbilityState.AbilityID; });
+
+		// The modifier instance isn't needed for snapshot resolution anymore
+		ReleaseAttributeModifierInstance(GetAttributeModifierInstance(RemovedAbilityState.AbilityID));
 	}
 }
 
@@ -1169,20 +1499,17 @@ void USimpleGameplayAbilityComponent::CompareSnapshots(const FAbilityState& Auth
 	{
 		AbilityInstance->ClientResolvePastState(AuthoritySnapshot.SnapshotTag, AuthoritySnapshot, *MatchingSnapshot);
 		MatchingSnapshot->WasClientSnapshotResolved = true;
+		AcknowledgeSnapshot(AuthorityAbilityState.AbilityID, AuthoritySnapshot.SequenceNumber);
 	}
 }
 
 void USimpleGameplayAbilityComponent::OnGameplayTagAdded(const FGameplayTagCounter& GameplayTag)
 {
-	FGameplayTagCounter* LocalTagCounter = LocalGameplayTags.FindByPredicate(
-		[GameplayTag](const FGameplayTagCounter& TagCounter)
-		{
-			return TagCounter.GameplayTag.MatchesTagExact(GameplayTag.GameplayTag);
-		});
+	FGameplayTagCounter* LocalTagCounter = LocalGameplayTagIndex.Find(LocalGameplayTags, GameplayTag.GameplayTag);
 
 	if (!LocalTagCounter)
 	{
-		LocalGameplayTags.AddUnique(GameplayTag);
+		LocalGameplayTagIndex.Add(LocalGameplayTags, GameplayTag);
 		SendEvent(FDefaultTags::GameplayTagAdded(), GameplayTag.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
 		return;
 	}
@@ -1192,15 +1519,11 @@ void USimpleGameplayAbilityComponent::OnGameplayTagAdded(const FGameplayTagCount
 
 void USimpleGameplayAbilityComponent::OnGameplayTagChanged(const FGameplayTagCounter& GameplayTag)
 {
-	FGameplayTagCounter* LocalTagCounter = LocalGameplayTags.FindByPredicate(
-		[GameplayTag](const FGameplayTagCounter& TagCounter)
-		{
-			return TagCounter.GameplayTag.MatchesTagExact(GameplayTag.GameplayTag);
-		});
+	FGameplayTagCounter* LocalTagCounter = LocalGameplayTagIndex.Find(LocalGameplayTags, GameplayTag.GameplayTag);
 
 	if (!LocalTagCounter)
 	{
-		LocalGameplayTags.AddUnique(GameplayTag);
+		LocalGameplayTagIndex.Add(LocalGameplayTags, GameplayTag);
 		SendEvent(FDefaultTags::GameplayTagAdded(), GameplayTag.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
 		return;
 	}
@@ -1210,15 +1533,8 @@ void USimpleGameplayAbilityComponent::OnGameplayTagChanged(const FGameplayTagCou
 
 void USimpleGameplayAbilityComponent::OnGameplayTagRemoved(const FGameplayTagCounter& GameplayTag)
 {
-	FGameplayTagCounter* LocalTagCounter = LocalGameplayTags.FindByPredicate(
-		[GameplayTag](const FGameplayTagCounter& TagCounter)
-		{
-			return TagCounter.GameplayTag.MatchesTagExact(GameplayTag.GameplayTag);
-		});
-
-	if (LocalTagCounter)
+	if (LocalGameplayTagIndex.Remove(LocalGameplayTags, GameplayTag.GameplayTag))
 	{
-		LocalGameplayTags.RemoveSingle(GameplayTag);
 		SendEvent(FDefaultTags::GameplayTagRemoved(), GameplayTag.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
 	}
 }
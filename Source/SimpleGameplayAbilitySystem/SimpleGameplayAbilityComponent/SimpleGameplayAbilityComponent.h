@@ -10,6 +10,7 @@
 
 struct FAbilitySideEffect;
 struct FAbilityOverride;
+struct FSimpleInstantModifierSpec;
 class UAbilityOverrideSet;
 class UAbilitySet;
 class USimpleAttributeSet;
@@ -39,14 +40,57 @@ public:
 	
 	UPROPERTY(EditAnywhere, Replicated, BlueprintReadOnly, Category = "AbilityComponent|Abilities")
 	TArray<TSubclassOf<USimpleGameplayAbility>> GrantedAbilities;
+
+	/**
+	 * How many seconds the state of an ended ability is kept before it's removed, so it can still replicate and be
+	 * queried (e.g. by GetActivationTime). 0 (default) keeps ended states until MaxEndedAbilityStates is exceeded.
+	 * Ended states are never removed if both are 0.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Abilities")
+	float EndedAbilityStateRetentionTime = 0.0f;
+
+	/* The most ended ability states to keep, the oldest are removed first. 0 (default) keeps them until EndedAbilityStateRetentionTime has passed. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Abilities")
+	int32 MaxEndedAbilityStates = 0;
+
+	/* The most ended instances kept per ability class for reuse, only used by abilities with AllowInstancePooling enabled. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Abilities")
+	int32 MaxPooledAbilityInstances = 8;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Attributes")
 	TArray<TObjectPtr<USimpleAttributeSet>> AttributeSets;
+
+	/**
+	 * The most ended instances kept per attribute modifier class for reuse. 0 disables modifier instance pooling, each
+	 * class then only reuses its last ended instance.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Attributes")
+	int32 MaxPooledAttributeModifierInstances = 16;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "AbilityComponent|Attributes", meta = (TitleProperty = "AttributeName"))
 	TArray<FFloatAttribute> FloatAttributes;
 	UPROPERTY(EditDefaultsOnly, Category = "AbilityComponent|Attributes", meta = (TitleProperty = "AttributeName"))
 	TArray<FStructAttribute> StructAttributes;
+
+	/**
+	 * If true, this component also keeps its gameplay tags as a bit set. Ability activation requirements and attribute
+	 * modifier target requirements are then checked with a few bitwise operations against masks their class defaults
+	 * build once, instead of tag container queries. Useful when many abilities or ticking modifiers check their requirements.
+	 * Only the requirement tags set in the class defaults are checked this way, changes made to them at runtime on an instance are ignored.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Tags")
+	bool UseGameplayTagBitSet = false;
+
+	/**
+	 * How many replicated event IDs are remembered to avoid handling an event twice (e.g. a predicted event coming back
+	 * from the server). Should cover all events that can be sent while waiting for an event to come back.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Events", meta = (ClampMin = 1))
+	int32 HandledEventIDCacheSize = 256;
+
+	/* How many seconds a replicated event ID is remembered. Should be longer than the worst round trip time. 0 or less remembers IDs until the cache is full. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Events")
+	float HandledEventIDExpiryTime = 10.0f;
 	
 	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
 	FFloatAttributeContainer AuthorityFloatAttributes;
@@ -119,6 +163,10 @@ public:
 	TArray<FGuid> CancelAbilitiesWithTags(FGameplayTagContainer Tags, FInstancedStruct CancellationContext);
 	
 	void AddAbilityStateSnapshot(FGuid AbilityInstanceID, FSimpleAbilitySnapshot State);
+
+	// Sent by the owning client after resolving a snapshot so the server can drop it and older snapshots from the state
+	UFUNCTION(Server, Unreliable)
+	void ServerAcknowledgeSnapshot(FGuid AbilityInstanceID, int32 SequenceNumber);
 	
 	/* Attribute Functions */
 	
@@ -156,6 +204,25 @@ public:
     // Increments discrete values. On server, accounts for regen before incrementing.
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Attributes")
 	bool IncrementFloatAttributeValue(EAttributeValueType ValueType, FGameplayTag AttributeTag, float Increment, float& Overflow);
+
+	/**
+	 * Returns a handle that finds the attribute without a tag lookup when passed to GetFloatAttributeValueByHandle or
+	 * SetFloatAttributeValueByHandle. Resolve the attributes you read or set every frame once (e.g. in BeginPlay) and keep the handles.
+	 * The handle stays usable if the attribute is added or removed later, it just has to look the attribute up again once.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Attributes")
+	FSimpleFloatAttributeHandle ResolveFloatAttribute(FGameplayTag AttributeTag);
+
+	// Not pure because it updates the cached attribute location in AttributeHandle
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "AbilityComponent|Attributes")
+	float GetFloatAttributeValueByHandle(EAttributeValueType ValueType, UPARAM(ref) FSimpleFloatAttributeHandle& AttributeHandle, bool& WasFound, bool bPredictIfClient = true) const;
+
+	UFUNCTION(BlueprintCallable, meta = (ReturnDisplayName = "WasFound"), Category = "AbilityComponent|Attributes")
+	bool SetFloatAttributeValueByHandle(EAttributeValueType ValueType, UPARAM(ref) FSimpleFloatAttributeHandle& AttributeHandle, float NewValue, float& Overflow);
+
+	// C++ versions of the ByHandle functions
+	float GetFloatAttributeValue(EAttributeValueType ValueType, FSimpleFloatAttributeHandle& AttributeHandle, bool& WasFound, bool bPredictIfClient = true) const;
+	bool SetFloatAttributeValue(EAttributeValueType ValueType, FSimpleFloatAttributeHandle& AttributeHandle, float NewValue, float& Overflow);
 	
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
 	bool OverrideFloatAttribute(FGameplayTag AttributeTag, FFloatAttribute NewAttribute);
@@ -179,7 +246,15 @@ public:
 	void ApplyAbilitySideEffects(USimpleGameplayAbilityComponent* Instigator, const TArray<FAbilitySideEffect>& AbilitySideEffects);
 
 	FFloatAttribute* GetFloatAttribute(FGameplayTag AttributeTag);
+	const FFloatAttribute* GetFloatAttribute(FGameplayTag AttributeTag) const;
+	FFloatAttribute* GetFloatAttribute(FSimpleFloatAttributeHandle& AttributeHandle);
+	const FFloatAttribute* GetFloatAttribute(FSimpleFloatAttributeHandle& AttributeHandle) const;
 	FStructAttribute* GetStructAttribute(FGameplayTag AttributeTag);
+	const FStructAttribute* GetStructAttribute(FGameplayTag AttributeTag) const;
+
+	// Find an attribute in the replicated authority attributes, on clients too. Used by FSimpleAttributeTransaction.
+	FFloatAttribute* GetAuthorityFloatAttribute(FGameplayTag AttributeTag);
+	FStructAttribute* GetAuthorityStructAttribute(FGameplayTag AttributeTag);
 	
 	/* Attribute Modifier Functions */
 	
@@ -189,6 +264,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Attributes")
 	bool ApplyAttributeModifierToSelf(TSubclassOf<USimpleAttributeModifier> ModifierClass, FInstancedStruct ModifierContext, FGuid& ModifierID);
 
+	/**
+	 * Applies a compiled instant modifier (see USimpleAttributeModifier::GetInstantModifierSpec) straight to the target's
+	 * float attributes, without creating a modifier instance, attribute state or snapshot. All modifications are applied
+	 * together or not at all. Attributes are only changed on the server.
+	 * @return True if the modifier applied
+	 */
+	bool ApplyInstantModifierSpec(USimpleGameplayAbilityComponent* ModifierTarget, const FSimpleInstantModifierSpec& ModifierSpec);
+
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Attributes")
 	void AddAttributeStateSnapshot(FGuid AbilityInstanceID, FSimpleAbilitySnapshot State);
 
@@ -224,21 +307,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Tags", meta = (AdvancedDisplay=1))
 	void RemoveGameplayTag(FGameplayTag Tag, FInstancedStruct Payload = FInstancedStruct());
 
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Tags")
-	bool HasGameplayTag(FGameplayTag Tag) const;
+	/**
+	 * @param OnlyMatchExact If false, a tag also matches its child tags on this component. i.e. "A.B" matches if this component has "A.B.C".
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Tags", meta = (AdvancedDisplay=1))
+	bool HasGameplayTag(FGameplayTag Tag, bool OnlyMatchExact = true) const;
 
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Tags")
-	bool HasAllGameplayTags(FGameplayTagContainer Tags) const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Tags", meta = (AdvancedDisplay=1))
+	bool HasAllGameplayTags(FGameplayTagContainer Tags, bool OnlyMatchExact = true) const;
 
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Tags", meta = (AdvancedDisplay=1))
+	bool HasAnyGameplayTags(FGameplayTagContainer Tags, bool OnlyMatchExact = true) const;
+
+	/* Returns the gameplay tags this component has. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Tags")
-	bool HasAnyGameplayTags(FGameplayTagContainer Tags) const;
+	const FGameplayTagContainer& GetGameplayTags() const;
+
+	// Exact matches only. Uses the tag bit set if UseGameplayTagBitSet is true, otherwise queries the mask's tags.
+	bool HasAllGameplayTags(const FGameplayTagBitMask& TagMask) const;
+	bool HasAnyGameplayTags(const FGameplayTagBitMask& TagMask) const;
 	
 	/* Replicated Event Functions */
 	
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Events", meta=(AutoCreateRefTerm = "ListenerFilter,Payload")) 
 	void SendEvent(
-		FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
-		UObject* Sender, TArray<UObject*> ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy);
+		FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload,
+		UObject* Sender, const TArray<UObject*>& ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy);
 	
 	void SendEventInternal(
 		FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload,
@@ -295,6 +389,12 @@ public:
 	FAbilityState* GetAbilityState(FGuid AbilityID, bool IsAuthorityState);
     const FAbilityState* GetAbilityState(FGuid AbilityID, bool IsAuthorityState) const;
 
+	// Removes ended ability states according to EndedAbilityStateRetentionTime and MaxEndedAbilityStates. Called when an ability ends.
+	void PruneEndedAbilityStates();
+
+	// Hit, miss and eviction counts of the replicated event de-duplication, for tuning HandledEventIDCacheSize and HandledEventIDExpiryTime
+	const FHandledEventIDCache& GetHandledEventIDCache() const { return HandledEventIDs; }
+
 
 	UFUNCTION(BlueprintCallable, BlueprintPure, BlueprintCallable, Category = "AbilityComponent|Utility")
 	USimpleAttributeHandler* GetAttributeHandler(const FGameplayTag& AttributeTag);
@@ -311,12 +411,20 @@ public:
 	/* Called by multiple instance abilities to set themselves up for deletion once the ability is over */
 	void RemoveInstancedAbility(USimpleGameplayAbility* AbilityToRemove);
 
+	/* Called by attribute modifiers once they've ended, keeps the instance for reuse by later modifier applications */
+	void ReleaseAttributeModifierInstance(USimpleAttributeModifier* Modifier);
+
+	/* Modifier instances that are active or waiting for the server to resolve their snapshots */
+	const TArray<TObjectPtr<USimpleAttributeModifier>>& GetInstancedAttributeModifiers() const { return InstancedAttributes; }
+
+	/* Called by ability and attribute modifier instances when their AbilityInstanceID changes to keep the instance lookups up to date */
+	void UpdateInstanceID(USimpleAbilityBase* Instance, FGuid OldInstanceID);
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	UFUNCTION()
-	void OnAbilityEndedEventReceived(FGameplayTag EventTag, FGameplayTag Domain, FInstancedStruct Payload, UObject* Sender);
+	void OnAbilityEndedEventReceived(FGameplayTag EventTag, FGameplayTag Domain, const FSimpleAbilityEndedEvent& EndedEvent, UObject* Sender);
 
 	UFUNCTION(BlueprintNativeEvent, Category = "AbilityComponent|Utility")
 	void OnAbilityEnded(FGuid AbilityID, FGameplayTag EndStatus, FInstancedStruct EndContext, bool WasCancelled);
@@ -338,11 +446,19 @@ protected:
     // Server-side helper to calculate current value including regeneration
     float GetAuthoritativeCurrentValueWithRegen(const FFloatAttribute& Attribute, EAttributeValueType ValueType) const;
 
+	// The tag and handle versions of GetFloatAttributeValue and SetFloatAttributeValue after they found the attribute
+	float GetFloatAttributeValueInternal(EAttributeValueType ValueType, const FFloatAttribute* Attribute, bool& WasFound, bool bPredictIfClient) const;
+	bool SetFloatAttributeValueInternal(EAttributeValueType ValueType, FFloatAttribute* Attribute, float NewValue, float& Overflow);
+
 
 	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State")
 	FGameplayTagCounterContainer AuthorityGameplayTags;
 	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State")
 	TArray<FGameplayTagCounter> LocalGameplayTags;
+
+	// Index and tag container of AuthorityGameplayTags and LocalGameplayTags, used by the tag functions
+	FGameplayTagCounterIndex AuthorityGameplayTagIndex;
+	FGameplayTagCounterIndex LocalGameplayTagIndex;
 	
 	USimpleGameplayAbility* GetGameplayAbilityInstance(FGuid AbilityInstanceID);
 
@@ -358,21 +474,69 @@ protected:
 	UPROPERTY()
 	TArray<TObjectPtr<USimpleAttributeModifier>> InstancedAttributes;
 
+	// Lookups into InstancedAbilities and InstancedAttributes. Single instance abilities are keyed by class, modifiers
+	// by the class of the instance last applied with ApplyAttributeModifierToTarget.
+	UPROPERTY()
+	TMap<TSubclassOf<USimpleGameplayAbility>, TObjectPtr<USimpleGameplayAbility>> SingleInstanceAbilitiesByClass;
+	UPROPERTY()
+	TMap<FGuid, TObjectPtr<USimpleGameplayAbility>> InstancedAbilitiesByID;
+	UPROPERTY()
+	TMap<TSubclassOf<USimpleAttributeModifier>, TObjectPtr<USimpleAttributeModifier>> InstancedAttributesByClass;
+	UPROPERTY()
+	TMap<FGuid, TObjectPtr<USimpleAttributeModifier>> InstancedAttributesByID;
+
+	// Ended instances of MultipleInstances abilities with AllowInstancePooling, reused by GetAbilityInstance
+	UPROPERTY()
+	TMap<TSubclassOf<USimpleGameplayAbility>, FAbilityInstancePool> AbilityInstancePools;
+
+	// Ended attribute modifier instances, reused by AcquireAttributeModifierInstance
+	UPROPERTY()
+	TMap<TSubclassOf<USimpleAttributeModifier>, FAttributeModifierInstancePool> AttributeModifierInstancePools;
+
+	// Adds a newly created modifier to InstancedAttributes and the modifier lookups
+	void AddAttributeModifierInstance(USimpleAttributeModifier* Modifier);
+
+	// Returns a reset instance from the modifier pool, the class' ended instance or a new one, in InstancedAttributes
+	USimpleAttributeModifier* AcquireAttributeModifierInstance(TSubclassOf<USimpleAttributeModifier> ModifierClass);
+
+	/**
+	 * Returns an instance initialized with the ID of a replicated attribute state, for fast forwarding or resolving its
+	 * snapshots on the client. The server's ID never matches a predicted instance's ID, so callers release it when done.
+	 */
+	USimpleAttributeModifier* AcquireAttributeModifierProxy(const FAbilityState& AuthorityAttributeState);
+
 	UPROPERTY()
 	TArray<TObjectPtr<USimpleAttributeHandler>> InstancedAttributeHandlers;
 	
 	// Used to keep track of which events have been handled locally to avoid double event sending with multicast
-	TArray<FGuid> HandledEventIDs;
+	FHandledEventIDCache HandledEventIDs;
 
 	// Used to keep track of the last time an ability was activated for checking cooldowns
 	TMap<TSubclassOf<USimpleGameplayAbility>, float> LastActivatedAbilityTimeStamps;
 
+	// Tag to index maps for the attribute arrays, used by GetFloatAttribute and GetStructAttribute. Mutable as const
+	// lookups can rebuild them.
+	mutable FAttributeTagIndex AuthorityFloatAttributeIndex;
+	mutable FAttributeTagIndex LocalFloatAttributeIndex;
+	mutable FAttributeTagIndex AuthorityStructAttributeIndex;
+	mutable FAttributeTagIndex LocalStructAttributeIndex;
+
+	// Ability ID to index maps for the ability state arrays, used by GetAbilityState
+	FAbilityStateIndex AuthorityAbilityStateIndex;
+	FAbilityStateIndex LocalAbilityStateIndex;
+
+	FTimerHandle EndedAbilityStatePruneTimerHandle;
+
 private:
 	// Called on the client after an ability or attribute state has been added, changed or removed
 	void OnStateAdded(const FAbilityState& NewAbilityState);
 	void OnStateChanged(const FAbilityState& AuthorityAbilityState);
 	void OnStateRemoved(const FAbilityState& RemovedAbilityState);
 	void CompareSnapshots(const FAbilityState& AuthorityAbilityState, FAbilityState& LocalAbilityState);
+
+	// Adds the snapshot and removes the oldest snapshots beyond the ability class' MaxSnapshotHistory, only resolved ones on clients
+	void AddSnapshotToHistory(FAbilityState& AbilityState, const FSimpleAbilitySnapshot& Snapshot);
+	void AcknowledgeSnapshot(FGuid AbilityInstanceID, int32 SequenceNumber);
 	
 	void OnFloatAttributeAdded(const FFloatAttribute& NewFloatAttribute);
 	void OnFloatAttributeChanged(const FFloatAttribute& ChangedFloatAttribute);
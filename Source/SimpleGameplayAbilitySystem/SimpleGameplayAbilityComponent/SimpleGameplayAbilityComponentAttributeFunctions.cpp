@@ -16,35 +16,32 @@ void USimpleGameplayAbilityComponent::AddFloatAttribute(FFloatAttribute Attribut
 		AttributeToAdd.LastRegenParamsUpdateTime_Server = GetServerTime();
 	}
 
-	for (FFloatAttribute& AuthorityAttribute : AuthorityFloatAttributes.Attributes)
+	if (FFloatAttribute* AuthorityAttribute = AuthorityFloatAttributeIndex.Find(AuthorityFloatAttributes.Attributes, AttributeToAdd.AttributeTag))
 	{
-		if (AuthorityAttribute.AttributeTag.MatchesTagExact(AttributeToAdd.AttributeTag))
+		// Attribute exists but we don't want to override it
+		if (!OverrideValuesIfExists)
 		{
-			// Attribute exists but we don't want to override it
-			if (!OverrideValuesIfExists)
-			{
-				return;
-			}
+			return;
+		}
 
-			// Attribute exists and we want to override it
-			FFloatAttribute OldAttribute = AuthorityAttribute; // Store old state for event comparison
-			AuthorityAttribute = AttributeToAdd; 
-			CompareFloatAttributesAndSendEvents(OldAttribute, AuthorityAttribute); // Send events based on what changed
+		// Attribute exists and we want to override it
+		FFloatAttribute OldAttribute = *AuthorityAttribute; // Store old state for event comparison
+		*AuthorityAttribute = AttributeToAdd; 
+		CompareFloatAttributesAndSendEvents(OldAttribute, *AuthorityAttribute); // Send events based on what changed
 
 
-			AuthorityFloatAttributes.MarkItemDirty(AuthorityAttribute);
-			return;
-		}
+		AuthorityFloatAttributes.MarkItemDirty(*AuthorityAttribute);
+		return;
 	}
 	
-	AuthorityFloatAttributes.Attributes.Add(AttributeToAdd); 
+	AuthorityFloatAttributeIndex.Add(AuthorityFloatAttributes.Attributes, AttributeToAdd); 
 	AuthorityFloatAttributes.MarkArrayDirty();
 	SendEvent(FDefaultTags::FloatAttributeAdded(), AttributeToAdd.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 void USimpleGameplayAbilityComponent::RemoveFloatAttribute(FGameplayTag AttributeTag)
 {
-	AuthorityFloatAttributes.Attributes.RemoveAll([AttributeTag](const FFloatAttribute& Attribute) { return Attribute.AttributeTag == AttributeTag; });
+	AuthorityFloatAttributeIndex.Remove(AuthorityFloatAttributes.Attributes, AttributeTag);
 	AuthorityFloatAttributes.MarkArrayDirty();
 	SendEvent(FDefaultTags::FloatAttributeRemoved(), AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
@@ -57,10 +54,10 @@ void USimpleGameplayAbilityComponent::AddStructAttribute(FStructAttribute Attrib
 		return;
 	}
 	
-	const int32 AttributeIndex = AuthorityStructAttributes.Attributes.Find(AttributeToAdd);
+	FStructAttribute* AuthorityAttribute = AuthorityStructAttributeIndex.Find(AuthorityStructAttributes.Attributes, AttributeToAdd.AttributeTag);
 	
 	// This is a new attribute
-	if (AttributeIndex == INDEX_NONE)
+	if (!AuthorityAttribute)
 	{
 		// Initialise the data within the struct
 		if (AttributeToAdd.StructType)
@@ -68,7 +65,7 @@ void USimpleGameplayAbilityComponent::AddStructAttribute(FStructAttribute Attrib
 			AttributeToAdd.AttributeValue.InitializeAs(AttributeToAdd.StructType);
 		}
 		
-		AuthorityStructAttributes.Attributes.AddUnique(AttributeToAdd);
+		AuthorityStructAttributeIndex.Add(AuthorityStructAttributes.Attributes, AttributeToAdd);
 		AuthorityStructAttributes.MarkArrayDirty();
 
 		SendEvent(FDefaultTags::StructAttributeAdded(), AttributeToAdd.AttributeTag, AttributeToAdd.AttributeValue, GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
@@ -83,13 +80,13 @@ void USimpleGameplayAbilityComponent::AddStructAttribute(FStructAttribute Attrib
 	}
 
 	// Attribute exists and we want to override it
-	AuthorityStructAttributes.Attributes[AttributeIndex] = AttributeToAdd;
-	AuthorityStructAttributes.MarkItemDirty(AuthorityStructAttributes.Attributes[AttributeIndex]);
+	*AuthorityAttribute = AttributeToAdd;
+	AuthorityStructAttributes.MarkItemDirty(*AuthorityAttribute);
 }
 
 void USimpleGameplayAbilityComponent::RemoveStructAttribute(FGameplayTag AttributeTag)
 {
-	AuthorityStructAttributes.Attributes.RemoveAll([AttributeTag](const FStructAttribute& Attribute) { return Attribute.AttributeTag == AttributeTag; });
+	AuthorityStructAttributeIndex.Remove(AuthorityStructAttributes.Attributes, AttributeTag);
 	AuthorityStructAttributes.MarkArrayDirty();
 	SendEvent(FDefaultTags::StructAttributeRemoved(), AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
@@ -106,34 +103,37 @@ bool USimpleGameplayAbilityComponent::ApplyAttributeModifierToTarget(
 		return false;
 	}
 	
+	// Modifiers that opted in and don't need an instance have no ID, there's no instance or state to refer to
+	if (ModifierClass.GetDefaultObject()->UseInstantModifierSpec)
+	{
+		if (const FSimpleInstantModifierSpec* ModifierSpec = USimpleAttributeModifier::GetInstantModifierSpec(ModifierClass))
+		{
+			ModifierID.Invalidate();
+			return ApplyInstantModifierSpec(ModifierTarget, *ModifierSpec);
+		}
+	}
+	
 	ModifierID = FGuid::NewGuid();
-	USimpleAttributeModifier* Modifier = nullptr;
 
-	for (USimpleAttributeModifier* InstancedModifier : InstancedAttributes)
+	if (const TObjectPtr<USimpleAttributeModifier>* InstancedModifier = InstancedAttributesByClass.Find(ModifierClass))
 	{
-		if (InstancedModifier->GetClass() == ModifierClass)
+		USimpleAttributeModifier* ActiveModifier = *InstancedModifier;
+
+		if (ActiveModifier && ActiveModifier->ModifierType == EAttributeModifierType::Duration && ActiveModifier->IsModifierActive())
 		{
-			if (InstancedModifier->ModifierType == EAttributeModifierType::Duration && InstancedModifier->IsModifierActive())
+			if (ActiveModifier->CanStack)
 			{
-				if (InstancedModifier->CanStack)
-				{
-					InstancedModifier->AddModifierStack(1);
-					return true;
-				}
-
-				InstancedModifier->EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
+				ActiveModifier->AddModifierStack(1);
+				return true;
 			}
 
-			Modifier = InstancedModifier;
-			break;
+			// Ending the modifier returns it to the pool, so it's acquired again below
+			ActiveModifier->EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
 		}
 	}
 
-	if (!Modifier)
-	{
-		Modifier = NewObject<USimpleAttributeModifier>(this, ModifierClass);
-		InstancedAttributes.Add(Modifier);
-	}
+	USimpleAttributeModifier* Modifier = AcquireAttributeModifierInstance(ModifierClass);
+	InstancedAttributesByClass.Add(ModifierClass, Modifier);
 	
 	Modifier->InitializeAbility(this, ModifierID, false);
 	CreateAttributeState(ModifierClass, ModifierContext, ModifierID);
@@ -141,6 +141,112 @@ bool USimpleGameplayAbilityComponent::ApplyAttributeModifierToTarget(
 	return Modifier->ApplyModifier(this, ModifierTarget, ModifierContext);
 }
 
+bool USimpleGameplayAbilityComponent::ApplyInstantModifierSpec(USimpleGameplayAbilityComponent* ModifierTarget, const FSimpleInstantModifierSpec& ModifierSpec)
+{
+	if (!ModifierTarget || !ModifierSpec.ModifierClass)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ApplyInstantModifierSpec]: ModifierTarget or the spec's ModifierClass is null."));
+		return false;
+	}
+
+	if (!HasAuthority() && ModifierSpec.ModifierApplicationPolicy != EAttributeModifierApplicationPolicy::ApplyClientPredicted)
+	{
+		return false;
+	}
+
+	if (!ModifierTarget->HasAllGameplayTags(ModifierSpec.TargetRequiredTags))
+	{
+		UE_LOG(LogSimpleGAS, Warning, TEXT("Target does not have required tags in USimpleGameplayAbilityComponent::ApplyInstantModifierSpec"));
+		return false;
+	}
+
+	if (ModifierTarget->HasAnyGameplayTags(ModifierSpec.TargetBlockingTags))
+	{
+		UE_LOG(LogSimpleGAS, Warning, TEXT("Target has blocking tags in USimpleGameplayAbilityComponent::ApplyInstantModifierSpec"));
+		return false;
+	}
+
+	// Like USimpleAttributeModifier::ApplyModifiersInternal we work on a transaction so a failed modification changes nothing
+	FSimpleAttributeTransaction Transaction(ModifierTarget);
+	float CurrentOverflow = 0;
+
+	for (const FSimpleInstantFloatModification& FloatModification : ModifierSpec.FloatModifications)
+	{
+		FFloatAttribute* AttributeToModify = Transaction.GetFloatAttribute(FloatModification.AttributeToModify);
+
+		float ModificationInputValue = 0;
+		bool WasInputValueFound = AttributeToModify != nullptr;
+
+		if (!AttributeToModify)
+		{
+			SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::ApplyInstantModifierSpec]: Attribute %s not found."), *FloatModification.AttributeToModify.ToString()));
+		}
+		else
+		{
+			switch (FloatModification.ModificationInputValueSource)
+			{
+				case EAttributeModificationValueSource::Manual:
+					ModificationInputValue = FloatModification.ManualInputValue;
+					break;
+
+				case EAttributeModificationValueSource::FromOverflow:
+					ModificationInputValue = CurrentOverflow;
+
+					if (FloatModification.ConsumeOverflow)
+					{
+						CurrentOverflow = 0;
+					}
+
+					break;
+
+				case EAttributeModificationValueSource::FromInstigatorAttribute:
+					ModificationInputValue = GetFloatAttributeValue(FloatModification.SourceAttributeValueType, FloatModification.SourceAttribute, WasInputValueFound);
+					break;
+
+				case EAttributeModificationValueSource::FromTargetAttribute:
+					ModificationInputValue = ModifierTarget->GetFloatAttributeValue(FloatModification.SourceAttributeValueType, FloatModification.SourceAttribute, WasInputValueFound);
+					break;
+
+				case EAttributeModificationValueSource::CustomInputValue:
+					WasInputValueFound = false;
+					break;
+			}
+		}
+
+		float NewAttributeValue = 0;
+		bool WasModificationApplied = WasInputValueFound;
+
+		if (WasInputValueFound && !USimpleAttributeModifier::ApplyFloatOperation(FloatModification.ModificationOperation,
+			USimpleAttributeModifier::GetFloatAttributeValueOfType(*AttributeToModify, FloatModification.ModifiedAttributeValueType),
+			ModificationInputValue, NewAttributeValue))
+		{
+			SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ApplyInstantModifierSpec]: Division by zero."));
+			WasModificationApplied = false;
+		}
+
+		if (!WasModificationApplied)
+		{
+			if (FloatModification.IfAttributeNotFound == EAttributeModiferNotFoundBehaviour::CancelModifier)
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		USimpleAttributeModifier::SetFloatAttributeValueOfType(*AttributeToModify, FloatModification.ModifiedAttributeValueType, NewAttributeValue, CurrentOverflow);
+		Transaction.MarkFloatAttributeModified(FloatModification.AttributeToModify);
+	}
+
+	// Client predicted specs only simulate the modification, the server changes the attributes
+	if (HasAuthority())
+	{
+		Transaction.Commit();
+	}
+
+	return true;
+}
+
 bool USimpleGameplayAbilityComponent::ApplyAttributeModifierToSelf(
 	TSubclassOf<USimpleAttributeModifier> ModifierClass,
 	FInstancedStruct ModifierContext,
@@ -157,7 +263,7 @@ void USimpleGameplayAbilityComponent::AddAttributeStateSnapshot(FGuid AbilityIns
 		{
 			if (AuthorityAttributeState.AbilityID == AbilityInstanceID)
 			{
-				AuthorityAttributeState.SnapshotHistory.Add(State);
+				AddSnapshotToHistory(AuthorityAttributeState, State);
 				AuthorityAttributeStates.MarkItemDirty(AuthorityAttributeState);
 				return;
 			}
@@ -169,7 +275,7 @@ void USimpleGameplayAbilityComponent::AddAttributeStateSnapshot(FGuid AbilityIns
 		{
 			if (ActiveAttribute.AbilityID == AbilityInstanceID)
 			{
-				ActiveAttribute.SnapshotHistory.Add(State);
+				AddSnapshotToHistory(ActiveAttribute, State);
 				return;
 			}
 		}
@@ -226,8 +332,10 @@ void USimpleGameplayAbilityComponent::CancelAttributeModifier(FGuid ModifierID)
 
 void USimpleGameplayAbilityComponent::CancelAttributeModifiersWithTags(FGameplayTagContainer Tags)
 {
-	// We go through all active modifiers and cancel them if any of their tags match the provided tags
-	for (USimpleAttributeModifier* ModifierInstance : InstancedAttributes)
+	// We go through all active modifiers and cancel them if any of their tags match the provided tags.
+	// Iterates a copy because ending a modifier releases it from InstancedAttributes.
+	TArray<TObjectPtr<USimpleAttributeModifier>> ModifierInstances = InstancedAttributes;
+	for (USimpleAttributeModifier* ModifierInstance : ModifierInstances)
 	{
 		if (ModifierInstance->IsModifierActive() && ModifierInstance->ModifierTags.HasAnyExact(Tags))
 		{
@@ -283,7 +391,7 @@ void USimpleGameplayAbilityComponent::CreateAttributeState(
 
 bool USimpleGameplayAbilityComponent::HasFloatAttribute(const FGameplayTag AttributeTag) const
 {
-	if (const_cast<USimpleGameplayAbilityComponent*>(this)->GetFloatAttribute(AttributeTag))
+	if (GetFloatAttribute(AttributeTag))
 	{
 		return true;
 	}
@@ -293,7 +401,7 @@ bool USimpleGameplayAbilityComponent::HasFloatAttribute(const FGameplayTag Attri
 
 bool USimpleGameplayAbilityComponent::HasStructAttribute(const FGameplayTag AttributeTag) const
 {
-	if (const_cast<USimpleGameplayAbilityComponent*>(this)->GetStructAttribute(AttributeTag))
+	if (GetStructAttribute(AttributeTag))
 	{
 		return true;
 	}
@@ -302,16 +410,28 @@ bool USimpleGameplayAbilityComponent::HasStructAttribute(const FGameplayTag Attr
 }
 
 float USimpleGameplayAbilityComponent::GetFloatAttributeValue(EAttributeValueType ValueType, FGameplayTag AttributeTag, bool& WasFound, bool bPredictIfClient) const
+{
+	const FFloatAttribute* Attribute = GetFloatAttribute(AttributeTag);
+	return GetFloatAttributeValueInternal(ValueType, Attribute, WasFound, bPredictIfClient);
+}
+
+float USimpleGameplayAbilityComponent::GetFloatAttributeValue(EAttributeValueType ValueType, FSimpleFloatAttributeHandle& AttributeHandle, bool& WasFound, bool bPredictIfClient) const
+{
+	const FFloatAttribute* Attribute = GetFloatAttribute(AttributeHandle);
+	return GetFloatAttributeValueInternal(ValueType, Attribute, WasFound, bPredictIfClient);
+}
+
+float USimpleGameplayAbilityComponent::GetFloatAttributeValueByHandle(EAttributeValueType ValueType, FSimpleFloatAttributeHandle& AttributeHandle, bool& WasFound, bool bPredictIfClient) const
+{
+	return GetFloatAttributeValue(ValueType, AttributeHandle, WasFound, bPredictIfClient);
+}
+
+float USimpleGameplayAbilityComponent::GetFloatAttributeValueInternal(EAttributeValueType ValueType, const FFloatAttribute* Attribute, bool& WasFound, bool bPredictIfClient) const
 {
 	WasFound = false;
-	const FFloatAttribute* Attribute = nullptr;
 
 	if (HasAuthority())
 	{
-		Attribute = AuthorityFloatAttributes.Attributes.FindByPredicate([AttributeTag](const FFloatAttribute& Attr) {
-			return Attr.AttributeTag == AttributeTag;
-		});
-
 		if (Attribute)
 		{
 			WasFound = true;
@@ -320,10 +440,6 @@ float USimpleGameplayAbilityComponent::GetFloatAttributeValue(EAttributeValueTyp
 	}
 	else // Client
 	{
-		Attribute = LocalFloatAttributes.FindByPredicate([AttributeTag](const FFloatAttribute& Attr) {
-			return Attr.AttributeTag == AttributeTag;
-		});
-
 		if (Attribute)
 		{
 			WasFound = true;
@@ -393,6 +509,30 @@ bool USimpleGameplayAbilityComponent::SetFloatAttributeValue(EAttributeValueType
 		return false;
 	}
 
+	return SetFloatAttributeValueInternal(ValueType, Attribute, NewValue, Overflow);
+}
+
+bool USimpleGameplayAbilityComponent::SetFloatAttributeValue(EAttributeValueType ValueType, FSimpleFloatAttributeHandle& AttributeHandle, float NewValue, float& Overflow)
+{
+	FFloatAttribute* Attribute = GetFloatAttribute(AttributeHandle);
+	
+	if (!Attribute)
+	{
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleAttributeFunctionLibrary::SetFloatAttributeValue]: Attribute %s not found."), *AttributeHandle.AttributeTag.ToString()));
+		return false;
+	}
+
+	return SetFloatAttributeValueInternal(ValueType, Attribute, NewValue, Overflow);
+}
+
+bool USimpleGameplayAbilityComponent::SetFloatAttributeValueByHandle(EAttributeValueType ValueType, FSimpleFloatAttributeHandle& AttributeHandle, float NewValue, float& Overflow)
+{
+	return SetFloatAttributeValue(ValueType, AttributeHandle, NewValue, Overflow);
+}
+
+bool USimpleGameplayAbilityComponent::SetFloatAttributeValueInternal(EAttributeValueType ValueType, FFloatAttribute* Attribute, float NewValue, float& Overflow)
+{
+	const FGameplayTag AttributeTag = Attribute->AttributeTag;
     float ValueToSet = NewValue;
 	
 	const float ClampedValue = ClampFloatAttributeValue(*Attribute, ValueType, ValueToSet, Overflow);
@@ -501,29 +641,43 @@ bool USimpleGameplayAbilityComponent::IncrementFloatAttributeValue(EAttributeVal
 	return SetFloatAttributeValue(ValueType, AttributeTag, CurrentValue + Increment, Overflow);
 }
 
+FSimpleFloatAttributeHandle USimpleGameplayAbilityComponent::ResolveFloatAttribute(FGameplayTag AttributeTag)
+{
+	FSimpleFloatAttributeHandle AttributeHandle;
+	AttributeHandle.AttributeTag = AttributeTag;
+	GetFloatAttribute(AttributeHandle);
+
+	return AttributeHandle;
+}
+
 bool USimpleGameplayAbilityComponent::OverrideFloatAttribute(FGameplayTag AttributeTag, FFloatAttribute NewAttribute)
 {
-	for (FFloatAttribute& Attribute : AuthorityFloatAttributes.Attributes)
+	if (FFloatAttribute* Attribute = AuthorityFloatAttributeIndex.Find(AuthorityFloatAttributes.Attributes, AttributeTag))
 	{
-		if (Attribute.AttributeTag.MatchesTagExact(AttributeTag))
+		CompareFloatAttributesAndSendEvents(*Attribute, NewAttribute);
+
+		const bool WasTagChanged = Attribute->AttributeTag != NewAttribute.AttributeTag;
+		
+		Attribute->AttributeName = NewAttribute.AttributeName;
+		Attribute->AttributeTag = NewAttribute.AttributeTag;
+		Attribute->BaseValue = NewAttribute.BaseValue;
+		Attribute->CurrentValue = NewAttribute.CurrentValue;
+		Attribute->ValueLimits = NewAttribute.ValueLimits;
+
+		Attribute->BaseRegenRate = NewAttribute.BaseRegenRate;
+		Attribute->CurrentRegenRate = NewAttribute.CurrentRegenRate;
+		Attribute->bIsRegenerating = NewAttribute.bIsRegenerating;
+		Attribute->LastRegenParamsUpdateTime_Server = GetServerTime();
+		
+		AuthorityFloatAttributes.MarkItemDirty(*Attribute);
+
+		// The attribute keeps its place in the array but has to be found by its new tag
+		if (WasTagChanged)
 		{
-			CompareFloatAttributesAndSendEvents(Attribute, NewAttribute);
-			
-			Attribute.AttributeName = NewAttribute.AttributeName;
-			Attribute.AttributeTag = NewAttribute.AttributeTag;
-			Attribute.BaseValue = NewAttribute.BaseValue;
-			Attribute.CurrentValue = NewAttribute.CurrentValue;
-			Attribute.ValueLimits = NewAttribute.ValueLimits;
-
-			Attribute.BaseRegenRate = NewAttribute.BaseRegenRate;
-			Attribute.CurrentRegenRate = NewAttribute.CurrentRegenRate;
-			Attribute.bIsRegenerating = NewAttribute.bIsRegenerating;
-			Attribute.LastRegenParamsUpdateTime_Server = GetServerTime();
-			
-			AuthorityFloatAttributes.MarkItemDirty(Attribute);
-			
-			return true;
+			AuthorityFloatAttributeIndex.Rebuild(AuthorityFloatAttributes.Attributes);
 		}
+		
+		return true;
 	}
 
 	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::OverrideFloatAttribute]: Attribute %s not found on server."), *AttributeTag.ToString()));
@@ -549,7 +703,7 @@ USimpleAttributeHandler* USimpleGameplayAbilityComponent::GetStructAttributeHand
 
 FInstancedStruct USimpleGameplayAbilityComponent::GetStructAttributeValue(FGameplayTag AttributeTag, bool& WasFound) const
 {
-	if (FStructAttribute* Attribute = const_cast<USimpleGameplayAbilityComponent*>(this)->GetStructAttribute(AttributeTag))
+	if (const FStructAttribute* Attribute = GetStructAttribute(AttributeTag))
 	{
 		WasFound = true;
 		return Attribute->AttributeValue;
@@ -693,7 +847,7 @@ void USimpleGameplayAbilityComponent::SendFloatAttributeChangedEvent(FGameplayTa
 		const FInstancedStruct EventPayload = FInstancedStruct::Make(Payload);
 		const FGameplayTag DomainTag = HasAuthority() ? FDefaultTags::AuthorityAttributeDomain() : FDefaultTags::LocalAttributeDomain();
 		
-		EventSubsystem->SendEvent(EventTag, DomainTag, EventPayload, GetOwner(), {});
+		EventSubsystem->DispatchEvent(EventTag, DomainTag, EventPayload, GetOwner(), {}, GetWorld());
 	}
 	else
 	{
@@ -713,121 +867,153 @@ FFloatAttribute* USimpleGameplayAbilityComponent::GetFloatAttribute(FGameplayTag
 {
 	if (HasAuthority())
 	{
-		for (FFloatAttribute& FloatAttribute : AuthorityFloatAttributes.Attributes)
-		{
-			if (FloatAttribute.AttributeTag.MatchesTagExact(AttributeTag))
-			{
-				return &FloatAttribute;
-			}
-		}
+		return AuthorityFloatAttributeIndex.Find(AuthorityFloatAttributes.Attributes, AttributeTag);
 	}
-	else
+
+	return LocalFloatAttributeIndex.Find(LocalFloatAttributes, AttributeTag);
+}
+
+const FFloatAttribute* USimpleGameplayAbilityComponent::GetFloatAttribute(FGameplayTag AttributeTag) const
+{
+	if (HasAuthority())
 	{
-		for (FFloatAttribute& FloatAttribute : LocalFloatAttributes)
-		{
-			if (FloatAttribute.AttributeTag.MatchesTagExact(AttributeTag))
-			{
-				return &FloatAttribute;
-			}
-		}
+		return AuthorityFloatAttributeIndex.Find(AuthorityFloatAttributes.Attributes, AttributeTag);
+	}
+
+	return LocalFloatAttributeIndex.Find(LocalFloatAttributes, AttributeTag);
+}
+
+FFloatAttribute* USimpleGameplayAbilityComponent::GetFloatAttribute(FSimpleFloatAttributeHandle& AttributeHandle)
+{
+	TArray<FFloatAttribute>& Attributes = HasAuthority() ? AuthorityFloatAttributes.Attributes : LocalFloatAttributes;
+	FAttributeTagIndex& AttributeIndex = HasAuthority() ? AuthorityFloatAttributeIndex : LocalFloatAttributeIndex;
+
+	// The generation catches attributes that moved, the tag check catches attributes that were changed in place
+	if (AttributeHandle.Generation == AttributeIndex.GetGeneration() && Attributes.IsValidIndex(AttributeHandle.AttributeIndex) &&
+		Attributes[AttributeHandle.AttributeIndex].AttributeTag == AttributeHandle.AttributeTag)
+	{
+		return &Attributes[AttributeHandle.AttributeIndex];
 	}
 
-	return nullptr;
+	FFloatAttribute* Attribute = AttributeIndex.Find(Attributes, AttributeHandle.AttributeTag);
+	AttributeHandle.AttributeIndex = Attribute ? static_cast<int32>(Attribute - Attributes.GetData()) : INDEX_NONE;
+	AttributeHandle.Generation = AttributeIndex.GetGeneration();
+
+	return Attribute;
+}
+
+const FFloatAttribute* USimpleGameplayAbilityComponent::GetFloatAttribute(FSimpleFloatAttributeHandle& AttributeHandle) const
+{
+	const TArray<FFloatAttribute>& Attributes = HasAuthority() ? AuthorityFloatAttributes.Attributes : LocalFloatAttributes;
+	FAttributeTagIndex& AttributeIndex = HasAuthority() ? AuthorityFloatAttributeIndex : LocalFloatAttributeIndex;
+
+	if (AttributeHandle.Generation == AttributeIndex.GetGeneration() && Attributes.IsValidIndex(AttributeHandle.AttributeIndex) &&
+		Attributes[AttributeHandle.AttributeIndex].AttributeTag == AttributeHandle.AttributeTag)
+	{
+		return &Attributes[AttributeHandle.AttributeIndex];
+	}
+
+	AttributeHandle.AttributeIndex = AttributeIndex.FindIndex(Attributes, AttributeHandle.AttributeTag);
+	AttributeHandle.Generation = AttributeIndex.GetGeneration();
+
+	return AttributeHandle.AttributeIndex != INDEX_NONE ? &Attributes[AttributeHandle.AttributeIndex] : nullptr;
 }
 
 FStructAttribute* USimpleGameplayAbilityComponent::GetStructAttribute(FGameplayTag AttributeTag)
 {
 	if (HasAuthority())
 	{
-		for (FStructAttribute& StructAttribute : AuthorityStructAttributes.Attributes)
-		{
-			if (StructAttribute.AttributeTag.MatchesTagExact(AttributeTag))
-			{
-				return &StructAttribute;
-			}
-		}
+		return AuthorityStructAttributeIndex.Find(AuthorityStructAttributes.Attributes, AttributeTag);
 	}
-	else
+
+	return LocalStructAttributeIndex.Find(LocalStructAttributes, AttributeTag);
+}
+
+const FStructAttribute* USimpleGameplayAbilityComponent::GetStructAttribute(FGameplayTag AttributeTag) const
+{
+	if (HasAuthority())
 	{
-		for (FStructAttribute& StructAttribute : LocalStructAttributes)
-		{
-			if (StructAttribute.AttributeTag.MatchesTagExact(AttributeTag))
-			{
-				return &StructAttribute;
-			}
-		}
+		return AuthorityStructAttributeIndex.Find(AuthorityStructAttributes.Attributes, AttributeTag);
 	}
 
-	return nullptr;
+	return LocalStructAttributeIndex.Find(LocalStructAttributes, AttributeTag);
+}
+
+FFloatAttribute* USimpleGameplayAbilityComponent::GetAuthorityFloatAttribute(FGameplayTag AttributeTag)
+{
+	return AuthorityFloatAttributeIndex.Find(AuthorityFloatAttributes.Attributes, AttributeTag);
+}
+
+FStructAttribute* USimpleGameplayAbilityComponent::GetAuthorityStructAttribute(FGameplayTag AttributeTag)
+{
+	return AuthorityStructAttributeIndex.Find(AuthorityStructAttributes.Attributes, AttributeTag);
 }
 
 void USimpleGameplayAbilityComponent::OnFloatAttributeAdded(const FFloatAttribute& NewFloatAttribute)
 {
-	LocalFloatAttributes.AddUnique(NewFloatAttribute);
+	if (!LocalFloatAttributeIndex.Find(LocalFloatAttributes, NewFloatAttribute.AttributeTag))
+	{
+		LocalFloatAttributeIndex.Add(LocalFloatAttributes, NewFloatAttribute);
+	}
+
 	SendEvent(FDefaultTags::FloatAttributeAdded(), NewFloatAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 void USimpleGameplayAbilityComponent::OnFloatAttributeChanged(const FFloatAttribute& ChangedFloatAttribute)
 {
-	for (FFloatAttribute& LocalFloatAttribute : LocalFloatAttributes)
+	if (FFloatAttribute* LocalFloatAttribute = LocalFloatAttributeIndex.Find(LocalFloatAttributes, ChangedFloatAttribute.AttributeTag))
 	{
-		if (LocalFloatAttribute.AttributeTag.MatchesTagExact(ChangedFloatAttribute.AttributeTag))
-		{
-			CompareFloatAttributesAndSendEvents(LocalFloatAttribute, ChangedFloatAttribute);
-			LocalFloatAttribute = ChangedFloatAttribute;
-			return;
-		}
+		CompareFloatAttributesAndSendEvents(*LocalFloatAttribute, ChangedFloatAttribute);
+		*LocalFloatAttribute = ChangedFloatAttribute;
+		return;
 	}
 
-	LocalFloatAttributes.AddUnique(ChangedFloatAttribute);
+	LocalFloatAttributeIndex.Add(LocalFloatAttributes, ChangedFloatAttribute);
 	SendEvent(FDefaultTags::FloatAttributeAdded(), ChangedFloatAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 void USimpleGameplayAbilityComponent::OnFloatAttributeRemoved(const FFloatAttribute& RemovedFloatAttribute)
 {
-	LocalFloatAttributes.Remove(RemovedFloatAttribute);
+	LocalFloatAttributeIndex.Remove(LocalFloatAttributes, RemovedFloatAttribute.AttributeTag);
 	SendEvent(FDefaultTags::FloatAttributeRemoved(), RemovedFloatAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 void USimpleGameplayAbilityComponent::OnStructAttributeAdded(const FStructAttribute& NewStructAttribute)
 {
-	if (!LocalStructAttributes.Contains(NewStructAttribute))
+	if (!LocalStructAttributeIndex.Find(LocalStructAttributes, NewStructAttribute.AttributeTag))
 	{
-		LocalStructAttributes.Add(NewStructAttribute);
+		LocalStructAttributeIndex.Add(LocalStructAttributes, NewStructAttribute);
 		SendEvent(FDefaultTags::StructAttributeAdded(), NewStructAttribute.AttributeTag, NewStructAttribute.AttributeValue, GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 	}
 }
 
 void USimpleGameplayAbilityComponent::OnStructAttributeChanged(const FStructAttribute& ChangedStructAttribute)
 {
-	for (FStructAttribute& LocalStructAttribute : LocalStructAttributes)
+	if (FStructAttribute* LocalStructAttribute = LocalStructAttributeIndex.Find(LocalStructAttributes, ChangedStructAttribute.AttributeTag))
 	{
-		if (LocalStructAttribute.AttributeTag.MatchesTagExact(ChangedStructAttribute.AttributeTag))
-		{
-			FStructAttributeModification Payload;
-			Payload.AttributeOwner = this;
-			Payload.AttributeTag = ChangedStructAttribute.AttributeTag;
-			Payload.OldValue = LocalStructAttribute.AttributeValue;
-			Payload.NewValue = ChangedStructAttribute.AttributeValue;
+		FStructAttributeModification Payload;
+		Payload.AttributeOwner = this;
+		Payload.AttributeTag = ChangedStructAttribute.AttributeTag;
+		Payload.OldValue = LocalStructAttribute->AttributeValue;
+		Payload.NewValue = ChangedStructAttribute.AttributeValue;
 
-			LocalStructAttribute = ChangedStructAttribute;
+		*LocalStructAttribute = ChangedStructAttribute;
 
-			if (LocalStructAttribute.StructAttributeHandler)
-			{
-				Payload.ModificationTags = GetStructAttributeHandlerInstance(LocalStructAttribute.StructAttributeHandler)->GetModificationEvents(ChangedStructAttribute.AttributeTag, Payload.OldValue, Payload.NewValue);
-			}
-			
-			SendEvent(FDefaultTags::StructAttributeValueChanged(), ChangedStructAttribute.AttributeTag, FInstancedStruct::Make(Payload), this, {}, ESimpleEventReplicationPolicy::NoReplication);
-			return;
+		if (LocalStructAttribute->StructAttributeHandler)
+		{
+			Payload.ModificationTags = GetStructAttributeHandlerInstance(LocalStructAttribute->StructAttributeHandler)->GetModificationEvents(ChangedStructAttribute.AttributeTag, Payload.OldValue, Payload.NewValue);
 		}
+		
+		SendEvent(FDefaultTags::StructAttributeValueChanged(), ChangedStructAttribute.AttributeTag, FInstancedStruct::Make(Payload), this, {}, ESimpleEventReplicationPolicy::NoReplication);
+		return;
 	}
 
-	LocalStructAttributes.Add(ChangedStructAttribute);
+	LocalStructAttributeIndex.Add(LocalStructAttributes, ChangedStructAttribute);
 	SendEvent(FDefaultTags::StructAttributeAdded(), ChangedStructAttribute.AttributeTag, ChangedStructAttribute.AttributeValue, GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 void USimpleGameplayAbilityComponent::OnStructAttributeRemoved(const FStructAttribute& RemovedStructAttribute)
 {
-	LocalStructAttributes.Remove(RemovedStructAttribute);
+	LocalStructAttributeIndex.Remove(LocalStructAttributes, RemovedStructAttribute.AttributeTag);
 	SendEvent(FDefaultTags::StructAttributeRemoved(), RemovedStructAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 ﻿#include "AttributesTest.h"
 
 #include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
 #include "Engine/World.h"
+#include "TimerManager.h"
 #include "GameFramework/Character.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleAbilityComponentTypes.h"
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAttributeModifier/SimpleModifierScheduler.h"
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleGameplayAbility/SimpleGameplayAbility.h"
+#include "SimpleGameplayAbilitySystem/BlueprintFunctionLibraries/FunctionSelectors/FunctionSelectors.h"
 #include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubsystem.h"
 #include "SimpleGameplayAbilitySystem/DefaultTags/DefaultTags.h"
 #include "NativeGameplayTags.h"
@@ -12,6 +17,7 @@
 
 #include "SGASCommonTestSetup.cpp"
 #include "MockClasses/AttributeEventReceiver.h"
+#include "MockClasses/TestAttributeModifiers.h"
 
 #define TestNamePrefix "GameTests.SGAS.Attributes"
 
@@ -23,7 +29,59 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_BasicManipulation, TestNamePref
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_Regeneration, TestNamePrefix ".Regeneration",
                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_PredictedModifierRelease, TestNamePrefix ".PredictedModifierRelease",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_ModifierPoolReuse, TestNamePrefix ".ModifierPoolReuse",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_CompiledModifierPrograms, TestNamePrefix ".CompiledModifierPrograms",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_ScheduledDurationModifier, TestNamePrefix ".ScheduledDurationModifier",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_FailedModificationRollback, TestNamePrefix ".FailedModificationRollback",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_SnapshotHistoryTrimming, TestNamePrefix ".SnapshotHistoryTrimming",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_InstantModifierSpecNativeOverrides, TestNamePrefix ".InstantModifierSpecNativeOverrides",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_TagBitSetRequirements, TestNamePrefix ".TagBitSetRequirements",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_EndedAbilityStatePruning, TestNamePrefix ".EndedAbilityStatePruning",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_HandledEventIDCache, TestNamePrefix ".HandledEventIDCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_FunctionSelectors, TestNamePrefix ".FunctionSelectors",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_ReplicatedIndexConsistency, TestNamePrefix ".ReplicatedIndexConsistency",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributesTest_GameplayTagCounters, TestNamePrefix ".GameplayTagCounters",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+
+
+// Native version of UTestFunctionSelectorModifier::AddTwiceOperation that counts its calls
+static int32 GNumNativeAddTwiceOperationCalls = 0;
+
+static bool NativeAddTwiceOperation(USimpleAttributeModifier* OwningModifier, FGameplayTag AttributeTag,
+	float CurrentAttributeValue, float OperationInputValue, float CurrentOverflow,
+	FGameplayTag& EventTagOverride, float& NewAttributeValue, float& NewOverflow)
+{
+	GNumNativeAddTwiceOperationCalls++;
+	NewAttributeValue = CurrentAttributeValue + OperationInputValue * 2.0f;
+	NewOverflow = CurrentOverflow;
+	return true;
+}
 
 class FAttributesTestContext
 {
@@ -302,6 +360,16 @@ public:
 		Res &= Test->TestNearlyEqual(
 			TEXT("BasicManipulation: Ratio set to -1.0 should clamp CurrentValue to Min (10.0f)"), Value, 10.0f, Tolerance);
 		
+		// --- Test attribute handles ---
+		FSimpleFloatAttributeHandle AttributeHandle = Context.SGASComponent->ResolveFloatAttribute(TestAttributeTag);
+		Res &= Test->TestTrue(TEXT("BasicManipulation: SetFloatAttributeValue with a handle should find the attribute"),
+			Context.SGASComponent->SetFloatAttributeValue(EAttributeValueType::BaseValue, AttributeHandle, 120.0f, Overflow));
+		Value = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::BaseValue, TestAttributeTag, bWasFound);
+		Res &= Test->TestNearlyEqual(TEXT("BasicManipulation: Value set with a handle should be read back with the tag"), Value, 120.0f, Tolerance);
+		Value = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::BaseValue, AttributeHandle, bWasFound);
+		Res &= Test->TestTrue(TEXT("BasicManipulation: GetFloatAttributeValue with a handle should find the attribute"), bWasFound);
+		Res &= Test->TestNearlyEqual(TEXT("BasicManipulation: Value read with a handle should match"), Value, 120.0f, Tolerance);
+
 		// --- Test RemoveFloatAttribute ---
 		DomainTag = TestAttributeTag; // Again here the domain is the attribute id
 		UAttributeEventReceiver* RemoveEventReceiver = NewObject<UAttributeEventReceiver>();
@@ -679,6 +747,932 @@ public:
 
 		return Res;
 	}
+
+	bool TestPredictedModifierRelease() const
+	{
+		FAttributesTestContext Context(TEXT(".PredictedModifierReleaseScenario"));
+		FDebugTestResult Res;
+		constexpr int32 NumApplications = 5;
+
+		Res &= Test->TestNotNull(TEXT("PredictedRelease: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("PredictedRelease: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("PredictedRelease: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+
+		// Act as a client so the modifiers are predicted and BeginPlay binds the replication callbacks
+		Context.Character->SetRole(ROLE_AutonomousProxy);
+		Context.Character->DispatchBeginPlay();
+		Res &= Test->TestFalse(TEXT("PredictedRelease: Component should not have authority"), Context.SGASComponent->HasAuthority());
+
+		// The server generates its own ID for each application, so nothing it replicates refers to the predicted instances
+		for (int32 i = 0; i < NumApplications; i++)
+		{
+			FGuid ModifierID;
+			Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestPredictedInstantModifier::StaticClass(), FInstancedStruct(), ModifierID);
+			Res &= Test->TestEqual(FString::Printf(TEXT("PredictedRelease: Application %d is released when it ends"), i), Context.SGASComponent->GetInstancedAttributeModifiers().Num(), 0);
+		}
+
+		TArray<FGuid> ServerModifierIDs;
+		for (int32 i = 0; i < NumApplications; i++)
+		{
+			FSimpleAbilitySnapshot ServerSnapshot;
+			ServerSnapshot.SequenceNumber = 0;
+			ServerSnapshot.SnapshotTag = FDefaultTags::AttributeModifierApplied();
+			ServerSnapshot.StateData = FInstancedStruct::Make(FAttributeModifierResult());
+
+			FAbilityState ServerState;
+			ServerState.AbilityID = FGuid::NewGuid();
+			ServerState.AbilityClass = UTestPredictedInstantModifier::StaticClass();
+			ServerState.AbilityStatus = EAbilityStatus::EndedSuccessfully;
+			ServerState.SnapshotHistory.Add(ServerSnapshot);
+			ServerModifierIDs.Add(ServerState.AbilityID);
+
+			int32 AddedIndex = Context.SGASComponent->AuthorityAttributeStates.AbilityStates.Add(ServerState);
+			Context.SGASComponent->AuthorityAttributeStates.PostReplicatedAdd(MakeArrayView(&AddedIndex, 1), Context.SGASComponent->AuthorityAttributeStates.AbilityStates.Num());
+		}
+
+		Res &= Test->TestEqual(TEXT("PredictedRelease: Added server states of predicted modifiers don't need an instance"), Context.SGASComponent->GetInstancedAttributeModifiers().Num(), 0);
+
+		// Replicate a change to each server state, which resolves its snapshot with a borrowed instance
+		for (int32 ChangedIndex = 0; ChangedIndex < Context.SGASComponent->AuthorityAttributeStates.AbilityStates.Num(); ChangedIndex++)
+		{
+			Context.SGASComponent->AuthorityAttributeStates.PostReplicatedChange(MakeArrayView(&ChangedIndex, 1), Context.SGASComponent->AuthorityAttributeStates.AbilityStates.Num());
+		}
+
+		Res &= Test->TestEqual(TEXT("PredictedRelease: Instances used to resolve snapshots are released"), Context.SGASComponent->GetInstancedAttributeModifiers().Num(), 0);
+
+		bool AllSnapshotsResolved = true;
+		for (const FAbilityState& LocalState : Context.SGASComponent->LocalAttributeStates)
+		{
+			if (ServerModifierIDs.Contains(LocalState.AbilityID))
+			{
+				AllSnapshotsResolved &= LocalState.SnapshotHistory.Num() > 0 && LocalState.SnapshotHistory[0].WasClientSnapshotResolved;
+			}
+		}
+		Res &= Test->TestTrue(TEXT("PredictedRelease: Server snapshots are resolved"), AllSnapshotsResolved);
+
+		// Only the authority can destroy the character when the context is torn down
+		Context.Character->SetRole(ROLE_Authority);
+
+		return Res;
+	}
+
+	bool TestModifierPoolReuse() const
+	{
+		FAttributesTestContext Context(TEXT(".ModifierPoolReuseScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("ModifierPool: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("ModifierPool: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("ModifierPool: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("ModifierPool: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		FFloatAttribute HealthAttribute;
+		HealthAttribute.AttributeName = TEXT("Health");
+		HealthAttribute.AttributeTag = TestAttributeTag;
+		HealthAttribute.BaseValue = 100.0f;
+		HealthAttribute.CurrentValue = 100.0f;
+		Context.SGASComponent->AddFloatAttribute(HealthAttribute);
+
+		FGuid FirstModifierID;
+		Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestDurationModifier::StaticClass(), FInstancedStruct(), FirstModifierID);
+		Res &= Test->TestEqual(TEXT("ModifierPool: Duration modifier is instanced"), Context.SGASComponent->GetInstancedAttributeModifiers().Num(), 1);
+		if (Context.SGASComponent->GetInstancedAttributeModifiers().Num() != 1) return Res;
+
+		USimpleAttributeModifier* FirstModifier = Context.SGASComponent->GetInstancedAttributeModifiers()[0];
+		USimpleModifierScheduler* ModifierScheduler = Context.World->GetSubsystem<USimpleModifierScheduler>();
+		Res &= Test->TestTrue(TEXT("ModifierPool: Modifier is scheduled"), ModifierScheduler && ModifierScheduler->IsModifierScheduled(FirstModifier));
+
+		// A timer bound to the instance shouldn't survive the instance being pooled
+		FTimerHandle PendingTimer;
+		Context.World->GetTimerManager().SetTimer(PendingTimer, FTimerDelegate::CreateUFunction(FirstModifier, GET_FUNCTION_NAME_CHECKED(USimpleAttributeModifier, OnPreApplyModifier)), 10.0f, false);
+
+		Context.SGASComponent->CancelAttributeModifier(FirstModifierID);
+		Res &= Test->TestFalse(TEXT("ModifierPool: Cancelled modifier is inactive"), FirstModifier->IsModifierActive());
+		Res &= Test->TestEqual(TEXT("ModifierPool: Cancelled modifier is released"), Context.SGASComponent->GetInstancedAttributeModifiers().Num(), 0);
+		Res &= Test->TestFalse(TEXT("ModifierPool: Pooled modifier is unscheduled"), ModifierScheduler && ModifierScheduler->IsModifierScheduled(FirstModifier));
+		Res &= Test->TestFalse(TEXT("ModifierPool: Pooled modifier has no pending timers"), Context.World->GetTimerManager().TimerExists(PendingTimer));
+
+		FGuid SecondModifierID;
+		Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestDurationModifier::StaticClass(), FInstancedStruct(), SecondModifierID);
+		const bool WasInstanceReused = Context.SGASComponent->GetInstancedAttributeModifiers().Num() == 1 && Context.SGASComponent->GetInstancedAttributeModifiers()[0] == FirstModifier;
+		Res &= Test->TestTrue(TEXT("ModifierPool: Pooled instance is reused"), WasInstanceReused);
+		Res &= Test->TestTrue(TEXT("ModifierPool: Reused modifier is active"), FirstModifier->IsModifierActive());
+		Res &= Test->TestTrue(TEXT("ModifierPool: Reused modifier has the new ID"), FirstModifier->AbilityInstanceID == SecondModifierID);
+		Res &= Test->TestEqual(TEXT("ModifierPool: Reused modifier has the default stacks"), FirstModifier->Stacks, 1);
+
+		Context.SGASComponent->CancelAttributeModifier(SecondModifierID);
+
+		// Without pooling the class' ended instance is kept and reused
+		Context.SGASComponent->MaxPooledAttributeModifierInstances = 0;
+		FGuid ThirdModifierID;
+		Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestDurationModifier::StaticClass(), FInstancedStruct(), ThirdModifierID);
+		Context.SGASComponent->CancelAttributeModifier(ThirdModifierID);
+		Res &= Test->TestEqual(TEXT("ModifierPool: Without pooling the ended instance is kept"), Context.SGASComponent->GetInstancedAttributeModifiers().Num(), 1);
+
+		FGuid FourthModifierID;
+		Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestDurationModifier::StaticClass(), FInstancedStruct(), FourthModifierID);
+		const bool WasEndedInstanceReused = Context.SGASComponent->GetInstancedAttributeModifiers().Num() == 1 && Context.SGASComponent->GetInstancedAttributeModifiers()[0] == FirstModifier;
+		Res &= Test->TestTrue(TEXT("ModifierPool: Without pooling the ended instance is reused"), WasEndedInstanceReused);
+		Res &= Test->TestTrue(TEXT("ModifierPool: Reused ended modifier has the new ID"), FirstModifier->AbilityInstanceID == FourthModifierID);
+
+		Context.SGASComponent->CancelAttributeModifier(FourthModifierID);
+
+		return Res;
+	}
+
+	bool TestCompiledModifierPrograms() const
+	{
+		constexpr float Tolerance = 0.001f;
+		FAttributesTestContext Context(TEXT(".CompiledModifierProgramsScenario"));
+		FDebugTestResult Res;
+		bool bFound = false;
+
+		Res &= Test->TestNotNull(TEXT("CompiledPrograms: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("CompiledPrograms: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("CompiledPrograms: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("CompiledPrograms: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		IConsoleVariable* UseCompiledProgramsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("SimpleGAS.Modifiers.UseCompiledPrograms"));
+		Res &= Test->TestNotNull(TEXT("CompiledPrograms: UseCompiledPrograms cvar exists"), UseCompiledProgramsCVar);
+		if (!UseCompiledProgramsCVar) return Res;
+
+		const int32 OriginalUseCompiledPrograms = UseCompiledProgramsCVar->GetInt();
+		float CurrentValues[2];
+		float BaseValues[2];
+
+		// The first run applies the compiled program, the second interprets FloatAttributeModifications
+		for (int32 RunIndex = 0; RunIndex < 2; RunIndex++)
+		{
+			UseCompiledProgramsCVar->Set(RunIndex == 0 ? 1 : 0);
+
+			FFloatAttribute HealthAttribute;
+			HealthAttribute.AttributeName = TEXT("Health");
+			HealthAttribute.AttributeTag = TestAttributeTag;
+			HealthAttribute.BaseValue = 100.0f;
+			HealthAttribute.CurrentValue = 50.0f;
+			Context.SGASComponent->AddFloatAttribute(HealthAttribute, true);
+
+			FGuid ModifierID;
+			const bool WasApplied = Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestMultiStepModifier::StaticClass(), FInstancedStruct(), ModifierID);
+			Res &= Test->TestTrue(FString::Printf(TEXT("CompiledPrograms: Run %d modifier applied"), RunIndex), WasApplied);
+
+			CurrentValues[RunIndex] = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound);
+			BaseValues[RunIndex] = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::BaseValue, TestAttributeTag, bFound);
+		}
+
+		UseCompiledProgramsCVar->Set(OriginalUseCompiledPrograms);
+
+		Res &= Test->TestNearlyEqual(TEXT("CompiledPrograms: Compiled current value"), CurrentValues[0], 120.0f, Tolerance); // (50 + 10) * 2
+		Res &= Test->TestNearlyEqual(TEXT("CompiledPrograms: Compiled base value"), BaseValues[0], 95.0f, Tolerance);
+		Res &= Test->TestNearlyEqual(TEXT("CompiledPrograms: Interpreted current value matches"), CurrentValues[1], CurrentValues[0], Tolerance);
+		Res &= Test->TestNearlyEqual(TEXT("CompiledPrograms: Interpreted base value matches"), BaseValues[1], BaseValues[0], Tolerance);
+
+		return Res;
+	}
+
+	bool TestScheduledDurationModifier() const
+	{
+		constexpr float Tolerance = 0.001f;
+		FAttributesTestContext Context(TEXT(".ScheduledDurationModifierScenario"));
+		FDebugTestResult Res;
+		bool bFound = false;
+
+		Res &= Test->TestNotNull(TEXT("ScheduledModifier: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("ScheduledModifier: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("ScheduledModifier: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("ScheduledModifier: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		USimpleModifierScheduler* ModifierScheduler = Context.World->GetSubsystem<USimpleModifierScheduler>();
+		Res &= Test->TestNotNull(TEXT("ScheduledModifier: World has a modifier scheduler"), ModifierScheduler);
+		if (!ModifierScheduler) return Res;
+
+		FFloatAttribute CounterAttribute;
+		CounterAttribute.AttributeName = TEXT("Counter");
+		CounterAttribute.AttributeTag = TestAttributeTag;
+		CounterAttribute.BaseValue = 100.0f;
+		CounterAttribute.CurrentValue = 0.0f;
+		Context.SGASComponent->AddFloatAttribute(CounterAttribute);
+
+		// Ticks every 0.5 seconds for 2 seconds, adding 1 each tick
+		FGuid ModifierID;
+		Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestDurationModifier::StaticClass(), FInstancedStruct(), ModifierID);
+		Res &= Test->TestEqual(TEXT("ScheduledModifier: Duration modifier is instanced"), Context.SGASComponent->GetInstancedAttributeModifiers().Num(), 1);
+		if (Context.SGASComponent->GetInstancedAttributeModifiers().Num() != 1) return Res;
+
+		USimpleAttributeModifier* Modifier = Context.SGASComponent->GetInstancedAttributeModifiers()[0];
+		Res &= Test->TestTrue(TEXT("ScheduledModifier: Modifier is scheduled"), ModifierScheduler->IsModifierScheduled(Modifier));
+
+		Context.World->Tick(ELevelTick::LEVELTICK_All, 0.5f);
+		float Counter = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound, false);
+		Res &= Test->TestNearlyEqual(TEXT("ScheduledModifier: First tick after 0.5s"), Counter, 1.0f, Tolerance);
+
+		Context.World->Tick(ELevelTick::LEVELTICK_All, 0.5f);
+		Counter = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound, false);
+		Res &= Test->TestNearlyEqual(TEXT("ScheduledModifier: Second tick after 1s"), Counter, 2.0f, Tolerance);
+
+		// Paused time doesn't count towards the next tick or the end
+		ModifierScheduler->PauseModifier(Modifier);
+		Context.World->Tick(ELevelTick::LEVELTICK_All, 1.0f);
+		Counter = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound, false);
+		Res &= Test->TestNearlyEqual(TEXT("ScheduledModifier: No ticks while paused"), Counter, 2.0f, Tolerance);
+		Res &= Test->TestTrue(TEXT("ScheduledModifier: Paused modifier is still active"), Modifier->IsModifierActive());
+
+		ModifierScheduler->UnpauseModifier(Modifier);
+		Context.World->Tick(ELevelTick::LEVELTICK_All, 0.5f);
+		Counter = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound, false);
+		Res &= Test->TestNearlyEqual(TEXT("ScheduledModifier: Third tick 0.5s after unpausing"), Counter, 3.0f, Tolerance);
+		Res &= Test->TestTrue(TEXT("ScheduledModifier: Modifier is active before its end"), Modifier->IsModifierActive());
+
+		// The last tick is due at the same time as the end and runs first
+		Context.World->Tick(ELevelTick::LEVELTICK_All, 0.5f);
+		Counter = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound, false);
+		Res &= Test->TestNearlyEqual(TEXT("ScheduledModifier: Last tick runs before the end"), Counter, 4.0f, Tolerance);
+		Res &= Test->TestFalse(TEXT("ScheduledModifier: Modifier ended after its duration"), Modifier->IsModifierActive());
+		Res &= Test->TestFalse(TEXT("ScheduledModifier: Ended modifier is unscheduled"), ModifierScheduler->IsModifierScheduled(Modifier));
+
+		Context.World->Tick(ELevelTick::LEVELTICK_All, 1.0f);
+		Counter = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound, false);
+		Res &= Test->TestNearlyEqual(TEXT("ScheduledModifier: No ticks after the end"), Counter, 4.0f, Tolerance);
+
+		return Res;
+	}
+
+	bool TestFailedModificationRollback() const
+	{
+		constexpr float Tolerance = 0.001f;
+		FAttributesTestContext Context(TEXT(".FailedModificationRollbackScenario"));
+		FDebugTestResult Res;
+		bool bFound = false;
+
+		Res &= Test->TestNotNull(TEXT("FailedModification: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("FailedModification: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("FailedModification: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("FailedModification: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		IConsoleVariable* UseCompiledProgramsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("SimpleGAS.Modifiers.UseCompiledPrograms"));
+		Res &= Test->TestNotNull(TEXT("FailedModification: UseCompiledPrograms cvar exists"), UseCompiledProgramsCVar);
+		if (!UseCompiledProgramsCVar) return Res;
+
+		const int32 OriginalUseCompiledPrograms = UseCompiledProgramsCVar->GetInt();
+
+		FFloatAttribute HealthAttribute;
+		HealthAttribute.AttributeName = TEXT("Health");
+		HealthAttribute.AttributeTag = TestAttributeTag;
+		HealthAttribute.BaseValue = 100.0f;
+		HealthAttribute.CurrentValue = 50.0f;
+		Context.SGASComponent->AddFloatAttribute(HealthAttribute);
+
+		// Compiled program, interpreted modifications and instant modifier spec
+		const TSubclassOf<USimpleAttributeModifier> ModifierClasses[3] = { UTestPartiallyFailingModifier::StaticClass(), UTestPartiallyFailingModifier::StaticClass(), UTestPartiallyFailingSpecModifier::StaticClass() };
+
+		for (int32 RunIndex = 0; RunIndex < 3; RunIndex++)
+		{
+			UseCompiledProgramsCVar->Set(RunIndex == 1 ? 0 : 1);
+
+			FGuid ModifierID;
+			const bool WasApplied = Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, ModifierClasses[RunIndex], FInstancedStruct(), ModifierID);
+			Res &= Test->TestFalse(FString::Printf(TEXT("FailedModification: Run %d modifier failed"), RunIndex), WasApplied);
+
+			// The first modification succeeded on the transaction's copy, but nothing should be committed
+			const float CurrentValue = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound);
+			Res &= Test->TestNearlyEqual(FString::Printf(TEXT("FailedModification: Run %d current value unchanged"), RunIndex), CurrentValue, 50.0f, Tolerance);
+			const float BaseValue = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::BaseValue, TestAttributeTag, bFound);
+			Res &= Test->TestNearlyEqual(FString::Printf(TEXT("FailedModification: Run %d base value unchanged"), RunIndex), BaseValue, 100.0f, Tolerance);
+			Res &= Test->TestFalse(FString::Printf(TEXT("FailedModification: Run %d missing attribute wasn't added"), RunIndex), Context.SGASComponent->HasFloatAttribute(TestMissingAttributeTag));
+		}
+
+		UseCompiledProgramsCVar->Set(OriginalUseCompiledPrograms);
+
+		return Res;
+	}
+
+	static TArray<int32> GetSequenceNumbers(const FAbilityState& AttributeState)
+	{
+		TArray<int32> SequenceNumbers;
+		for (const FSimpleAbilitySnapshot& Snapshot : AttributeState.SnapshotHistory)
+		{
+			SequenceNumbers.Add(Snapshot.SequenceNumber);
+		}
+		return SequenceNumbers;
+	}
+
+	static FSimpleAbilitySnapshot MakeTestSnapshot(const FGuid& AttributeID, const int32 SequenceNumber)
+	{
+		FSimpleAbilitySnapshot Snapshot;
+		Snapshot.AbilityID = AttributeID;
+		Snapshot.SequenceNumber = SequenceNumber;
+		Snapshot.SnapshotTag = FDefaultTags::AttributeModifierApplied();
+		return Snapshot;
+	}
+
+	bool TestSnapshotHistoryTrimming() const
+	{
+		FAttributesTestContext Context(TEXT(".SnapshotHistoryTrimmingScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("SnapshotHistory: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("SnapshotHistory: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("SnapshotHistory: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		// The server keeps the latest MaxSnapshotHistory (3) snapshots
+		FAbilityState ServerState;
+		ServerState.AbilityID = FGuid::NewGuid();
+		ServerState.AbilityClass = UTestSnapshotHistoryModifier::StaticClass();
+		Context.SGASComponent->AuthorityAttributeStates.AbilityStates.Add(ServerState);
+		const FAbilityState& AuthorityState = Context.SGASComponent->AuthorityAttributeStates.AbilityStates.Last();
+
+		for (int32 SequenceNumber = 0; SequenceNumber < 5; SequenceNumber++)
+		{
+			Context.SGASComponent->AddAttributeStateSnapshot(ServerState.AbilityID, MakeTestSnapshot(ServerState.AbilityID, SequenceNumber));
+		}
+
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: Server keeps the latest snapshots"), GetSequenceNumbers(AuthorityState) == TArray<int32>({ 2, 3, 4 }));
+
+		// Acknowledged snapshots are removed, except for the latest one
+		Context.SGASComponent->ServerAcknowledgeSnapshot(ServerState.AbilityID, 2);
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: Acknowledged snapshots are removed"), GetSequenceNumbers(AuthorityState) == TArray<int32>({ 3, 4 }));
+
+		Context.SGASComponent->ServerAcknowledgeSnapshot(ServerState.AbilityID, 10);
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: The latest snapshot is kept when acknowledged"), GetSequenceNumbers(AuthorityState) == TArray<int32>({ 4 }));
+
+		Context.SGASComponent->ServerAcknowledgeSnapshot(FGuid::NewGuid(), 10);
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: Acknowledging an unknown state changes nothing"), GetSequenceNumbers(AuthorityState) == TArray<int32>({ 4 }));
+
+		// Clients only drop resolved snapshots, the unresolved ones still wait for the server
+		Context.Character->SetRole(ROLE_AutonomousProxy);
+
+		FAbilityState ClientState;
+		ClientState.AbilityID = FGuid::NewGuid();
+		ClientState.AbilityClass = UTestSnapshotHistoryModifier::StaticClass();
+		Context.SGASComponent->LocalAttributeStates.Add(ClientState);
+		FAbilityState& LocalState = Context.SGASComponent->LocalAttributeStates.Last();
+
+		for (int32 SequenceNumber = 0; SequenceNumber < 3; SequenceNumber++)
+		{
+			Context.SGASComponent->AddAttributeStateSnapshot(ClientState.AbilityID, MakeTestSnapshot(ClientState.AbilityID, SequenceNumber));
+		}
+
+		LocalState.SnapshotHistory[0].WasClientSnapshotResolved = true;
+		Context.SGASComponent->AddAttributeStateSnapshot(ClientState.AbilityID, MakeTestSnapshot(ClientState.AbilityID, 3));
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: Client drops the oldest resolved snapshot"), GetSequenceNumbers(LocalState) == TArray<int32>({ 1, 2, 3 }));
+
+		Context.SGASComponent->AddAttributeStateSnapshot(ClientState.AbilityID, MakeTestSnapshot(ClientState.AbilityID, 4));
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: Client keeps unresolved snapshots beyond the limit"), GetSequenceNumbers(LocalState) == TArray<int32>({ 1, 2, 3, 4 }));
+
+		LocalState.SnapshotHistory[1].WasClientSnapshotResolved = true;
+		Context.SGASComponent->AddAttributeStateSnapshot(ClientState.AbilityID, MakeTestSnapshot(ClientState.AbilityID, 5));
+		Res &= Test->TestTrue(TEXT("SnapshotHistory: Client only drops resolved snapshots"), GetSequenceNumbers(LocalState) == TArray<int32>({ 1, 3, 4, 5 }));
+
+		// Only the authority can destroy the character when the context is torn down
+		Context.Character->SetRole(ROLE_Authority);
+
+		return Res;
+	}
+
+	bool TestInstantModifierSpecNativeOverrides() const
+	{
+		FAttributesTestContext Context(TEXT(".InstantModifierSpecNativeOverridesScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("SpecNativeOverrides: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("SpecNativeOverrides: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("SpecNativeOverrides: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("SpecNativeOverrides: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		bool bFound = false;
+		constexpr float Tolerance = 0.001f;
+
+		// The opted in native class gets a spec, its native subclass overrides CanApplyModifier_Implementation and doesn't
+		Res &= Test->TestNotNull(TEXT("SpecNativeOverrides: Opted in native class has a spec"), USimpleAttributeModifier::GetInstantModifierSpec(UTestPartiallyFailingSpecModifier::StaticClass()));
+		Res &= Test->TestNull(TEXT("SpecNativeOverrides: Native subclass with an override has no spec"), USimpleAttributeModifier::GetInstantModifierSpec(UTestNativeCanApplySpecModifier::StaticClass()));
+		Res &= Test->TestNull(TEXT("SpecNativeOverrides: Native class that didn't opt in has no spec"), USimpleAttributeModifier::GetInstantModifierSpec(UTestMultiStepModifier::StaticClass()));
+
+		FFloatAttribute HealthAttribute;
+		HealthAttribute.AttributeName = TEXT("Health");
+		HealthAttribute.AttributeTag = TestAttributeTag;
+		HealthAttribute.BaseValue = 100.0f;
+		HealthAttribute.CurrentValue = 50.0f;
+		Context.SGASComponent->AddFloatAttribute(HealthAttribute);
+
+		FFloatAttribute ArmorAttribute;
+		ArmorAttribute.AttributeName = TEXT("Armor");
+		ArmorAttribute.AttributeTag = TestMissingAttributeTag;
+		Context.SGASComponent->AddFloatAttribute(ArmorAttribute);
+
+		// Both modifications would succeed now, so only the CanApplyModifier override can stop the application
+		FGuid ModifierID;
+		const bool WasApplied = Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestNativeCanApplySpecModifier::StaticClass(), FInstancedStruct(), ModifierID);
+		Res &= Test->TestFalse(TEXT("SpecNativeOverrides: CanApplyModifier override blocked the modifier"), WasApplied);
+
+		const float CurrentValue = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound);
+		Res &= Test->TestNearlyEqual(TEXT("SpecNativeOverrides: Current value unchanged"), CurrentValue, 50.0f, Tolerance);
+
+		return Res;
+	}
+
+	bool TestTagBitSetRequirements() const
+	{
+		constexpr float Tolerance = 0.001f;
+		FDebugTestResult Res;
+		bool bFound = false;
+
+		// The same target tags in the order they're added and removed, with whether the modifier should apply
+		struct FTagStep
+		{
+			FGameplayTag Tag;
+			bool bAddTag;
+			bool bShouldApply;
+		};
+
+		const FTagStep TagSteps[] = {
+			{ FGameplayTag(), false, false },
+			{ TestRequiredTag, true, true },
+			{ TestBlockingTag, true, false },
+			{ TestRequiredTag, false, false },
+			{ TestBlockingTag, false, false },
+			{ TestRequiredTag, true, true },
+		};
+
+		// Container queries first, then the tag bit set with the class default masks
+		for (int32 RunIndex = 0; RunIndex < 2; RunIndex++)
+		{
+			const bool UseBitSet = RunIndex == 1;
+			FAttributesTestContext Context(UseBitSet ? TEXT(".TagBitSetRequirementsBitSetScenario") : TEXT(".TagBitSetRequirementsContainerScenario"));
+
+			Res &= Test->TestNotNull(TEXT("TagBitSet: World should be created"), Context.World);
+			if (!Context.World) return Res;
+			Res &= Test->TestNotNull(TEXT("TagBitSet: Character should be spawned"), Context.Character);
+			if (!Context.Character) return Res;
+			Res &= Test->TestNotNull(TEXT("TagBitSet: SGASComponent should be created"), Context.SGASComponent);
+			if (!Context.SGASComponent) return Res;
+			Res &= Test->TestTrue(TEXT("TagBitSet: Component should have authority"), Context.SGASComponent->HasAuthority());
+			if (!Context.SGASComponent->HasAuthority()) return Res;
+
+			// The tag index picks up UseGameplayTagBitSet in BeginPlay
+			Context.SGASComponent->UseGameplayTagBitSet = UseBitSet;
+			Context.Character->DispatchBeginPlay();
+
+			FFloatAttribute HealthAttribute;
+			HealthAttribute.AttributeName = TEXT("Health");
+			HealthAttribute.AttributeTag = TestAttributeTag;
+			HealthAttribute.BaseValue = 100.0f;
+			HealthAttribute.CurrentValue = 0.0f;
+			Context.SGASComponent->AddFloatAttribute(HealthAttribute);
+
+			float ExpectedValue = 0.0f;
+
+			for (int32 StepIndex = 0; StepIndex < UE_ARRAY_COUNT(TagSteps); StepIndex++)
+			{
+				const FTagStep& TagStep = TagSteps[StepIndex];
+
+				if (TagStep.Tag.IsValid())
+				{
+					if (TagStep.bAddTag)
+					{
+						Context.SGASComponent->AddGameplayTag(TagStep.Tag);
+					}
+					else
+					{
+						Context.SGASComponent->RemoveGameplayTag(TagStep.Tag);
+					}
+				}
+
+				FGuid ModifierID;
+				const bool WasApplied = Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestTagRequirementModifier::StaticClass(), FInstancedStruct(), ModifierID);
+				Res &= Test->TestEqual(FString::Printf(TEXT("TagBitSet: Run %d step %d applied as expected"), RunIndex, StepIndex), WasApplied, TagStep.bShouldApply);
+
+				ExpectedValue += TagStep.bShouldApply ? 1.0f : 0.0f;
+				const float CurrentValue = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound);
+				Res &= Test->TestNearlyEqual(FString::Printf(TEXT("TagBitSet: Run %d step %d current value"), RunIndex, StepIndex), CurrentValue, ExpectedValue, Tolerance);
+			}
+		}
+
+		return Res;
+	}
+
+	// Checks that every state in the authority or local array is found at its own index and that removed states aren't found
+	bool TestAbilityStateIndex(USimpleGameplayAbilityComponent* Component, const bool IsAuthorityState, const TArray<FGuid>& RemovedIDs, const FString& Prefix) const
+	{
+		FDebugTestResult Res;
+		TArray<FAbilityState>& AbilityStates = IsAuthorityState ? Component->AuthorityAbilityStates.AbilityStates : Component->LocalAbilityStates;
+
+		for (int32 StateIndex = 0; StateIndex < AbilityStates.Num(); StateIndex++)
+		{
+			const FAbilityState* FoundState = Component->GetAbilityState(AbilityStates[StateIndex].AbilityID, IsAuthorityState);
+			Res &= Test->TestTrue(FString::Printf(TEXT("%s: State %d found at its index"), *Prefix, StateIndex), FoundState == &AbilityStates[StateIndex]);
+		}
+
+		for (const FGuid& RemovedID : RemovedIDs)
+		{
+			Res &= Test->TestNull(FString::Printf(TEXT("%s: Removed state %s not found"), *Prefix, *RemovedID.ToString()), Component->GetAbilityState(RemovedID, IsAuthorityState));
+		}
+
+		return Res;
+	}
+
+	bool TestEndedAbilityStatePruning() const
+	{
+		FAttributesTestContext Context(TEXT(".EndedAbilityStatePruningScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("StatePruning: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("StatePruning: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("StatePruning: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("StatePruning: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		Res &= Test->TestEqual(TEXT("StatePruning: Retention time is off by default"), Context.SGASComponent->EndedAbilityStateRetentionTime, 0.0f);
+		Res &= Test->TestEqual(TEXT("StatePruning: Max ended states is off by default"), Context.SGASComponent->MaxEndedAbilityStates, 0);
+
+		// An active state first, so removing the ended states behind it swaps later states into their place
+		const double ServerTime = Context.SGASComponent->GetServerTime();
+		const double SecondsSinceEnded[] = { 50.0, 10.0, 40.0, 20.0, 30.0 };
+		TArray<FGuid> StateIDs;
+
+		FAbilityState ActiveState;
+		ActiveState.AbilityID = FGuid::NewGuid();
+		ActiveState.AbilityStatus = ActivationSuccess;
+		Context.SGASComponent->AuthorityAbilityStates.AbilityStates.Add(ActiveState);
+
+		for (const double Seconds : SecondsSinceEnded)
+		{
+			FAbilityState EndedState;
+			EndedState.AbilityID = FGuid::NewGuid();
+			EndedState.AbilityStatus = EndedSuccessfully;
+			EndedState.EndedTimeStamp = ServerTime - Seconds;
+			Context.SGASComponent->AuthorityAbilityStates.AbilityStates.Add(EndedState);
+			StateIDs.Add(EndedState.AbilityID);
+		}
+
+		Res &= TestAbilityStateIndex(Context.SGASComponent, true, {}, TEXT("StatePruning: Initial"));
+
+		Context.SGASComponent->PruneEndedAbilityStates();
+		Res &= Test->TestEqual(TEXT("StatePruning: Nothing removed with both limits off"), Context.SGASComponent->AuthorityAbilityStates.AbilityStates.Num(), 6);
+
+		// Removes the states that ended 50, 40 and 30 seconds ago
+		Context.SGASComponent->EndedAbilityStateRetentionTime = 25.0f;
+		Context.SGASComponent->PruneEndedAbilityStates();
+		Res &= Test->TestEqual(TEXT("StatePruning: Expired states removed"), Context.SGASComponent->AuthorityAbilityStates.AbilityStates.Num(), 3);
+		Res &= TestAbilityStateIndex(Context.SGASComponent, true, { StateIDs[0], StateIDs[2], StateIDs[4] }, TEXT("StatePruning: Retention time"));
+		Res &= Test->TestNotNull(TEXT("StatePruning: Active state kept"), Context.SGASComponent->GetAbilityState(ActiveState.AbilityID, true));
+
+		// Removes the state that ended 20 seconds ago, the oldest of the two left
+		Context.SGASComponent->EndedAbilityStateRetentionTime = 0.0f;
+		Context.SGASComponent->MaxEndedAbilityStates = 1;
+		Context.SGASComponent->PruneEndedAbilityStates();
+		Res &= Test->TestEqual(TEXT("StatePruning: Oldest state over the limit removed"), Context.SGASComponent->AuthorityAbilityStates.AbilityStates.Num(), 2);
+		Res &= TestAbilityStateIndex(Context.SGASComponent, true, { StateIDs[0], StateIDs[2], StateIDs[3], StateIDs[4] }, TEXT("StatePruning: Max ended states"));
+		Res &= Test->TestNotNull(TEXT("StatePruning: Newest ended state kept"), Context.SGASComponent->GetAbilityState(StateIDs[1], true));
+		Res &= Test->TestNotNull(TEXT("StatePruning: Active state still kept"), Context.SGASComponent->GetAbilityState(ActiveState.AbilityID, true));
+
+		return Res;
+	}
+
+	bool TestHandledEventIDCache() const
+	{
+		FDebugTestResult Res;
+		const FGuid EventA = FGuid::NewGuid();
+		const FGuid EventB = FGuid::NewGuid();
+		const FGuid EventC = FGuid::NewGuid();
+		const FGuid EventD = FGuid::NewGuid();
+
+		// Capacity: adding a fourth ID to a full cache of three evicts the oldest
+		FHandledEventIDCache Cache;
+		Cache.Initialize(3, 0.0);
+		Cache.Add(EventA, 0.0);
+		Cache.Add(EventB, 0.0);
+		Cache.Add(EventC, 0.0);
+		Cache.Add(EventD, 0.0);
+
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Full cache holds its capacity"), Cache.Num(), 3);
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Oldest ID evicted"), Cache.GetNumEvictions(), static_cast<uint64>(1));
+		Res &= Test->TestFalse(TEXT("HandledEventIDCache: Evicted ID is a miss"), Cache.Consume(EventA, 0.0));
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: Second ID is a hit"), Cache.Consume(EventB, 0.0));
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: Third ID is a hit"), Cache.Consume(EventC, 0.0));
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: Newest ID is a hit"), Cache.Consume(EventD, 0.0));
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Capacity hits"), Cache.GetNumHits(), static_cast<uint64>(3));
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Capacity misses"), Cache.GetNumMisses(), static_cast<uint64>(1));
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Consumed IDs are forgotten"), Cache.Num(), 0);
+
+		// Expiry: an expired ID found by Consume counts as both an eviction and a miss
+		Cache.Initialize(8, 1.0);
+		Cache.Add(EventA, 0.0);
+		Cache.Add(EventB, 0.5);
+
+		Res &= Test->TestFalse(TEXT("HandledEventIDCache: Expired ID is a miss"), Cache.Consume(EventA, 1.4));
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Expired ID counts as an eviction"), Cache.GetNumEvictions(), static_cast<uint64>(1));
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Expired ID counts as a miss"), Cache.GetNumMisses(), static_cast<uint64>(1));
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: ID within the expiry time is a hit"), Cache.Consume(EventB, 1.4));
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Expiry hits"), Cache.GetNumHits(), static_cast<uint64>(1));
+
+		// Adding drops IDs that expired in the meantime
+		Cache.Add(EventC, 2.0);
+		Cache.Add(EventD, 3.5);
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Expired ID dropped on add"), Cache.Num(), 1);
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Dropped ID counts as an eviction"), Cache.GetNumEvictions(), static_cast<uint64>(2));
+		Res &= Test->TestFalse(TEXT("HandledEventIDCache: Dropped ID is a miss"), Cache.Consume(EventC, 3.5));
+
+		// Consume then re-add: consumed entries free their place without counting as evictions
+		Cache.Initialize(2, 0.0);
+		Cache.Add(EventA, 0.0);
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: First consume is a hit"), Cache.Consume(EventA, 0.0));
+		Res &= Test->TestFalse(TEXT("HandledEventIDCache: Second consume is a miss"), Cache.Consume(EventA, 0.0));
+
+		Cache.Add(EventA, 0.0);
+		Cache.Add(EventB, 0.0);
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Re-added ID and new ID fit"), Cache.Num(), 2);
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Consumed entry wasn't evicted"), Cache.GetNumEvictions(), static_cast<uint64>(0));
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: Re-added ID is a hit"), Cache.Consume(EventA, 0.0));
+
+		Cache.Add(EventC, 0.0);
+		Cache.Add(EventD, 0.0);
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Full cache after re-adding"), Cache.Num(), 2);
+		Res &= Test->TestEqual(TEXT("HandledEventIDCache: Oldest unconsumed ID evicted"), Cache.GetNumEvictions(), static_cast<uint64>(1));
+		Res &= Test->TestFalse(TEXT("HandledEventIDCache: Evicted ID is forgotten"), Cache.Consume(EventB, 0.0));
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: Third ID is kept"), Cache.Consume(EventC, 0.0));
+		Res &= Test->TestTrue(TEXT("HandledEventIDCache: Newest ID is kept"), Cache.Consume(EventD, 0.0));
+
+		return Res;
+	}
+
+	bool TestFunctionSelectors() const
+	{
+		constexpr float Tolerance = 0.001f;
+		FAttributesTestContext Context(TEXT(".FunctionSelectorsScenario"));
+		FDebugTestResult Res;
+		bool bFound = false;
+
+		Res &= Test->TestNotNull(TEXT("FunctionSelectors: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("FunctionSelectors: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("FunctionSelectors: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("FunctionSelectors: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		FFloatAttribute HealthAttribute;
+		HealthAttribute.AttributeName = TEXT("Health");
+		HealthAttribute.AttributeTag = TestAttributeTag;
+		HealthAttribute.BaseValue = 100.0f;
+		HealthAttribute.CurrentValue = 10.0f;
+		Context.SGASComponent->AddFloatAttribute(HealthAttribute);
+
+		// Start from an empty cache so the wrong signature below is resolved, and logged, in this test
+		UFunctionSelectors::ClearResolvedFunctions();
+		const FName OperationName = GET_FUNCTION_NAME_CHECKED(UTestFunctionSelectorModifier, AddTwiceOperation);
+		GNumNativeAddTwiceOperationCalls = 0;
+
+		// ProcessEvent, then the registered native function, then ProcessEvent again once it's unregistered
+		const TCHAR* RunNames[] = { TEXT("ProcessEvent"), TEXT("Native"), TEXT("Unregistered") };
+		const int32 ExpectedNativeCalls[] = { 0, 1, 1 };
+
+		for (int32 RunIndex = 0; RunIndex < 3; RunIndex++)
+		{
+			if (RunIndex == 1)
+			{
+				UFunctionSelectors::RegisterNativeFunction(UTestFunctionSelectorModifier::StaticClass(), OperationName, &NativeAddTwiceOperation);
+			}
+			else if (RunIndex == 2)
+			{
+				UFunctionSelectors::UnregisterNativeFunction(UTestFunctionSelectorModifier::StaticClass(), OperationName);
+			}
+
+			FGuid ModifierID;
+			const bool WasApplied = Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestFunctionSelectorModifier::StaticClass(), FInstancedStruct(), ModifierID);
+			Res &= Test->TestTrue(FString::Printf(TEXT("FunctionSelectors: %s modifier applied"), RunNames[RunIndex]), WasApplied);
+
+			// Each application adds 10 whichever way the operation was called
+			const float CurrentValue = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound);
+			Res &= Test->TestNearlyEqual(FString::Printf(TEXT("FunctionSelectors: %s current value"), RunNames[RunIndex]), CurrentValue, 20.0f + RunIndex * 10.0f, Tolerance);
+			Res &= Test->TestEqual(FString::Printf(TEXT("FunctionSelectors: %s native calls"), RunNames[RunIndex]), GNumNativeAddTwiceOperationCalls, ExpectedNativeCalls[RunIndex]);
+		}
+
+		// A function that doesn't match the prototype is rejected once and stays rejected from the cache
+		Test->AddExpectedError(TEXT("don't match the selector's prototype"), EAutomationExpectedErrorFlags::Contains, 1);
+
+		for (int32 RunIndex = 0; RunIndex < 2; RunIndex++)
+		{
+			FGuid ModifierID;
+			const bool WasApplied = Context.SGASComponent->ApplyAttributeModifierToTarget(Context.SGASComponent, UTestWrongSelectorSignatureModifier::StaticClass(), FInstancedStruct(), ModifierID);
+			Res &= Test->TestFalse(FString::Printf(TEXT("FunctionSelectors: Wrong signature run %d rejected"), RunIndex), WasApplied);
+
+			const float CurrentValue = Context.SGASComponent->GetFloatAttributeValue(EAttributeValueType::CurrentValue, TestAttributeTag, bFound);
+			Res &= Test->TestNearlyEqual(FString::Printf(TEXT("FunctionSelectors: Wrong signature run %d current value unchanged"), RunIndex), CurrentValue, 40.0f, Tolerance);
+		}
+
+		return Res;
+	}
+
+	bool TestReplicatedIndexConsistency() const
+	{
+		FAttributesTestContext Context(TEXT(".ReplicatedIndexConsistencyScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("ReplicatedIndex: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("ReplicatedIndex: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("ReplicatedIndex: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+
+		// Simulate a client, BeginPlay binds the replication callbacks
+		Context.Character->SetRole(ROLE_AutonomousProxy);
+		Context.Character->DispatchBeginPlay();
+		USimpleGameplayAbilityComponent* Component = Context.SGASComponent;
+
+		Res &= Test->TestFalse(TEXT("ReplicatedIndex: Component should be a client"), Component->HasAuthority());
+
+		// Ability states: replicated adds, a change and a remove, then pruning of the ended client only states
+		TArray<FAbilityState>& ServerAbilityStates = Component->AuthorityAbilityStates.AbilityStates;
+		TArray<FGuid> StateIDs;
+
+		for (int32 StateIndex = 0; StateIndex < 5; StateIndex++)
+		{
+			// Not activated yet, so the client only tracks the state without activating an ability instance
+			FAbilityState ServerState;
+			ServerState.AbilityID = FGuid::NewGuid();
+			ServerState.AbilityClass = USimpleGameplayAbility::StaticClass();
+			ServerState.ActivationPolicy = EAbilityActivationPolicy::ClientOnly;
+			ServerState.AbilityStatus = PreActivation;
+			ServerAbilityStates.Add(ServerState);
+			StateIDs.Add(ServerState.AbilityID);
+		}
+
+		TArray<int32> AddedIndices = { 0, 1, 2, 3, 4 };
+		Component->AuthorityAbilityStates.PostReplicatedAdd(AddedIndices, ServerAbilityStates.Num());
+		Res &= Test->TestEqual(TEXT("ReplicatedIndex: Added states are local"), Component->LocalAbilityStates.Num(), 5);
+		Res &= TestAbilityStateIndex(Component, false, {}, TEXT("ReplicatedIndex: Added states"));
+
+		TArray<int32> ChangedIndices = { 2 };
+		Component->AuthorityAbilityStates.PostReplicatedChange(ChangedIndices, ServerAbilityStates.Num());
+		Res &= Test->TestEqual(TEXT("ReplicatedIndex: Changed state doesn't add a local state"), Component->LocalAbilityStates.Num(), 5);
+		Res &= TestAbilityStateIndex(Component, false, {}, TEXT("ReplicatedIndex: Changed state"));
+
+		// Removing the first state swaps the last one into its place
+		TArray<int32> RemovedIndices = { 0 };
+		Component->AuthorityAbilityStates.PreReplicatedRemove(RemovedIndices, ServerAbilityStates.Num() - 1);
+		ServerAbilityStates.RemoveAt(0);
+		Res &= Test->TestEqual(TEXT("ReplicatedIndex: Removed state isn't local"), Component->LocalAbilityStates.Num(), 4);
+		Res &= TestAbilityStateIndex(Component, false, { StateIDs[0] }, TEXT("ReplicatedIndex: Removed state"));
+
+		const double ServerTime = Component->GetServerTime();
+
+		const int32 EndedStateIndices[] = { 1, 3 };
+
+		for (const int32 EndedStateIndex : EndedStateIndices)
+		{
+			FAbilityState* LocalState = Component->GetAbilityState(StateIDs[EndedStateIndex], false);
+			Res &= Test->TestNotNull(FString::Printf(TEXT("ReplicatedIndex: State %d is local"), EndedStateIndex), LocalState);
+			if (!LocalState) return Res;
+
+			LocalState->AbilityStatus = EndedSuccessfully;
+			LocalState->EndedTimeStamp = ServerTime - 60.0;
+		}
+
+		Component->EndedAbilityStateRetentionTime = 30.0f;
+		Component->PruneEndedAbilityStates();
+		Res &= Test->TestEqual(TEXT("ReplicatedIndex: Pruned states aren't local"), Component->LocalAbilityStates.Num(), 2);
+		Res &= TestAbilityStateIndex(Component, false, { StateIDs[0], StateIDs[1], StateIDs[3] }, TEXT("ReplicatedIndex: Pruned states"));
+
+		// Float attributes: replicated adds, a change and a remove
+		const FGameplayTag AttributeTags[] = { TestAttributeTag, TestMissingAttributeTag, TestRequiredTag, TestBlockingTag };
+		TArray<FFloatAttribute>& ServerAttributes = Component->AuthorityFloatAttributes.Attributes;
+
+		for (int32 AttributeIndex = 0; AttributeIndex < UE_ARRAY_COUNT(AttributeTags); AttributeIndex++)
+		{
+			FFloatAttribute& ServerAttribute = ServerAttributes.AddDefaulted_GetRef();
+			ServerAttribute.AttributeName = *FString::Printf(TEXT("Attribute%d"), AttributeIndex);
+			ServerAttribute.AttributeTag = AttributeTags[AttributeIndex];
+			ServerAttribute.CurrentValue = AttributeIndex * 10.0f;
+			ServerAttribute.PostReplicatedAdd(Component->AuthorityFloatAttributes);
+		}
+
+		ServerAttributes[2].CurrentValue = 25.0f;
+		ServerAttributes[2].PostReplicatedChange(Component->AuthorityFloatAttributes);
+
+		ServerAttributes[0].PreReplicatedRemove(Component->AuthorityFloatAttributes);
+		ServerAttributes.RemoveAt(0);
+
+		Res &= Test->TestEqual(TEXT("ReplicatedIndex: Local attributes follow the server"), Component->LocalFloatAttributes.Num(), 3);
+		Res &= Test->TestNull(TEXT("ReplicatedIndex: Removed attribute not found"), Component->GetFloatAttribute(TestAttributeTag));
+
+		for (const FFloatAttribute& ServerAttribute : ServerAttributes)
+		{
+			const FFloatAttribute* LocalAttribute = Component->GetFloatAttribute(ServerAttribute.AttributeTag);
+			Res &= Test->TestNotNull(FString::Printf(TEXT("ReplicatedIndex: Attribute %s found"), *ServerAttribute.AttributeTag.ToString()), LocalAttribute);
+			if (!LocalAttribute) continue;
+
+			Res &= Test->TestTrue(FString::Printf(TEXT("ReplicatedIndex: Attribute %s found in the local array"), *ServerAttribute.AttributeTag.ToString()),
+				Component->LocalFloatAttributes.IsValidIndex(static_cast<int32>(LocalAttribute - Component->LocalFloatAttributes.GetData())));
+			Res &= Test->TestEqual(FString::Printf(TEXT("ReplicatedIndex: Attribute %s has the server value"), *ServerAttribute.AttributeTag.ToString()),
+				LocalAttribute->CurrentValue, ServerAttribute.CurrentValue);
+		}
+
+		Context.Character->SetRole(ROLE_Authority);
+
+		return Res;
+	}
+
+	bool TestGameplayTagCounters() const
+	{
+		FAttributesTestContext Context(TEXT(".GameplayTagCountersScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("TagCounters: World should be created"), Context.World);
+		if (!Context.World) return Res;
+		Res &= Test->TestNotNull(TEXT("TagCounters: Character should be spawned"), Context.Character);
+		if (!Context.Character) return Res;
+		Res &= Test->TestNotNull(TEXT("TagCounters: SGASComponent should be created"), Context.SGASComponent);
+		if (!Context.SGASComponent) return Res;
+		Res &= Test->TestTrue(TEXT("TagCounters: Component should have authority"), Context.SGASComponent->HasAuthority());
+		if (!Context.SGASComponent->HasAuthority()) return Res;
+
+		USimpleGameplayAbilityComponent* Component = Context.SGASComponent;
+		const FGameplayTag ParentTag = TestRequiredTag.GetTag().RequestDirectParent();
+		Res &= Test->TestTrue(TEXT("TagCounters: Both test tags share a parent"), TestBlockingTag.GetTag().RequestDirectParent() == ParentTag);
+
+		FGameplayTagContainer BothTags;
+		BothTags.AddTag(TestRequiredTag);
+		BothTags.AddTag(TestBlockingTag);
+
+		FGameplayTagContainer ParentTags;
+		ParentTags.AddTag(ParentTag);
+
+		// TestRequiredTag is counted twice
+		Component->AddGameplayTag(TestRequiredTag);
+		Component->AddGameplayTag(TestRequiredTag);
+		Component->AddGameplayTag(TestBlockingTag);
+		Component->AddGameplayTag(TestAttributeTag);
+
+		Res &= Test->TestEqual(TEXT("TagCounters: Each tag is in the container once"), Component->GetGameplayTags().Num(), 3);
+		Res &= Test->TestTrue(TEXT("TagCounters: Has the added tag"), Component->HasGameplayTag(TestRequiredTag));
+		Res &= Test->TestTrue(TEXT("TagCounters: Has all added tags"), Component->HasAllGameplayTags(BothTags));
+		Res &= Test->TestFalse(TEXT("TagCounters: Parent isn't an exact match"), Component->HasGameplayTag(ParentTag));
+		Res &= Test->TestTrue(TEXT("TagCounters: Parent matches hierarchically"), Component->HasGameplayTag(ParentTag, false));
+		Res &= Test->TestFalse(TEXT("TagCounters: Parent container isn't an exact match"), Component->HasAnyGameplayTags(ParentTags));
+		Res &= Test->TestTrue(TEXT("TagCounters: Parent container matches hierarchically"), Component->HasAllGameplayTags(ParentTags, false));
+
+		// The first removal only decrements the counter
+		Component->RemoveGameplayTag(TestRequiredTag);
+		Res &= Test->TestTrue(TEXT("TagCounters: Tag counted twice is kept after one removal"), Component->HasGameplayTag(TestRequiredTag));
+
+		// Removing the first counter swaps the last counter (TestAttributeTag) into its place
+		Component->RemoveGameplayTag(TestRequiredTag);
+		Res &= Test->TestFalse(TEXT("TagCounters: Tag removed after its last removal"), Component->HasGameplayTag(TestRequiredTag));
+		Res &= Test->TestTrue(TEXT("TagCounters: Swapped tag is kept"), Component->HasGameplayTag(TestAttributeTag));
+		Res &= Test->TestTrue(TEXT("TagCounters: Parent still matches through the other child"), Component->HasGameplayTag(ParentTag, false));
+		Res &= Test->TestEqual(TEXT("TagCounters: Two tags left"), Component->GetGameplayTags().Num(), 2);
+
+		// The swapped counter is still found, so adding it again increments it instead of adding a second counter
+		Component->AddGameplayTag(TestAttributeTag);
+		Component->RemoveGameplayTag(TestAttributeTag);
+		Res &= Test->TestTrue(TEXT("TagCounters: Swapped tag counted twice is kept after one removal"), Component->HasGameplayTag(TestAttributeTag));
+		Component->RemoveGameplayTag(TestAttributeTag);
+		Res &= Test->TestFalse(TEXT("TagCounters: Swapped tag removed after its last removal"), Component->HasGameplayTag(TestAttributeTag));
+
+		// Removing the last child also removes the implicit parent
+		Component->RemoveGameplayTag(TestBlockingTag);
+		Res &= Test->TestFalse(TEXT("TagCounters: Parent no longer matches"), Component->HasGameplayTag(ParentTag, false));
+		Res &= Test->TestEqual(TEXT("TagCounters: No tags left"), Component->GetGameplayTags().Num(), 0);
+
+		// Removing a tag that isn't counted does nothing
+		Component->RemoveGameplayTag(TestBlockingTag);
+		Res &= Test->TestEqual(TEXT("TagCounters: Removing a missing tag does nothing"), Component->GetGameplayTags().Num(), 0);
+
+		return Res;
+	}
 };
 
 
@@ -692,4 +1686,82 @@ bool FAttributesTest_Regeneration::RunTest(const FString& Parameters)
 {
     FAttributesTestScenarios TestScenarios(this);
     return TestScenarios.TestRegeneration();
+}
+
+bool FAttributesTest_PredictedModifierRelease::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestPredictedModifierRelease();
+}
+
+bool FAttributesTest_ModifierPoolReuse::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestModifierPoolReuse();
+}
+
+bool FAttributesTest_CompiledModifierPrograms::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestCompiledModifierPrograms();
+}
+
+bool FAttributesTest_ScheduledDurationModifier::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestScheduledDurationModifier();
+}
+
+bool FAttributesTest_FailedModificationRollback::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestFailedModificationRollback();
+}
+
+bool FAttributesTest_SnapshotHistoryTrimming::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestSnapshotHistoryTrimming();
+}
+
+bool FAttributesTest_InstantModifierSpecNativeOverrides::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestInstantModifierSpecNativeOverrides();
+}
+
+bool FAttributesTest_TagBitSetRequirements::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestTagBitSetRequirements();
+}
+
+bool FAttributesTest_EndedAbilityStatePruning::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestEndedAbilityStatePruning();
+}
+
+bool FAttributesTest_HandledEventIDCache::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestHandledEventIDCache();
+}
+
+bool FAttributesTest_FunctionSelectors::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestFunctionSelectors();
+}
+
+bool FAttributesTest_ReplicatedIndexConsistency::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestReplicatedIndexConsistency();
+}
+
+bool FAttributesTest_GameplayTagCounters::RunTest(const FString& Parameters)
+{
+    FAttributesTestScenarios TestScenarios(this);
+    return TestScenarios.TestGameplayTagCounters();
 }
\ No newline at end of file
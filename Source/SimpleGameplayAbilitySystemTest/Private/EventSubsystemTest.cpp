@@ -0,0 +1,374 @@
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubsystem.h"
+#include "NativeGameplayTags.h"
+#include "Framework/DebugTestResult.h"
+
+#include "SGASCommonTestSetup.cpp"
+#include "MockClasses/SimpleEventRecorder.h"
+
+#define EventTestNamePrefix "GameTests.SGAS.Events"
+
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TestEventParentTag, "Test.SGAS.Events.Parent");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TestEventChildTag, "Test.SGAS.Events.Parent.Child");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TestEventOtherTag, "Test.SGAS.Events.Other");
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEventSubsystemTest_Dispatch, EventTestNamePrefix ".Dispatch",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEventSubsystemTest_Coalescing, EventTestNamePrefix ".Coalescing",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEventSubsystemTest_WorldScoping, EventTestNamePrefix ".WorldScoping",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEventSubsystemTest_InvalidListenerSweep, EventTestNamePrefix ".InvalidListenerSweep",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+
+class FEventSubsystemTestContext
+{
+public:
+	FEventSubsystemTestContext(FName TestNameSuffix)
+		: TestFixture(FName(*(FString(EventTestNamePrefix) + TestNameSuffix.ToString())))
+	{
+		EventSubsystem = TestFixture.GetSubsystem();
+	}
+
+	USimpleEventRecorder* CreateRecorder(FName Label, UObject* Outer = GetTransientPackage())
+	{
+		USimpleEventRecorder* Recorder = NewObject<USimpleEventRecorder>(Outer);
+		Recorder->Label = Label;
+		Recorder->ReceivedLog = &ReceivedLog;
+		return Recorder;
+	}
+
+	FGuid Listen(USimpleEventRecorder* Recorder, FGameplayTagContainer EventFilter, bool OnlyMatchExactEvent = true,
+	             TArray<UObject*> SenderFilter = {}, bool OnlyTriggerOnce = false) const
+	{
+		FSimpleEventDelegate Delegate;
+		Delegate.BindDynamic(Recorder, &USimpleEventRecorder::HandleEvent);
+		return EventSubsystem->ListenForEvent(Recorder, OnlyTriggerOnce, EventFilter, FGameplayTagContainer(), Delegate,
+		                                      {}, SenderFilter, OnlyMatchExactEvent);
+	}
+
+	FTestFixture TestFixture;
+	USimpleEventSubsystem* EventSubsystem = nullptr;
+	TArray<FName> ReceivedLog;
+};
+
+
+class FEventSubsystemTestScenarios
+{
+public:
+	FAutomationTestBase* Test;
+
+	FEventSubsystemTestScenarios(FAutomationTestBase* InTest)
+		: Test(InTest)
+	{
+	}
+
+	bool TestDispatch() const
+	{
+		FEventSubsystemTestContext Context(TEXT(".DispatchScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("Dispatch: EventSubsystem should exist"), Context.EventSubsystem);
+		if (!Context.EventSubsystem) return Res;
+
+		USimpleEventRecorder* ExactParent = Context.CreateRecorder(TEXT("ExactParent"));
+		USimpleEventRecorder* ExactChild = Context.CreateRecorder(TEXT("ExactChild"));
+		USimpleEventRecorder* ParentOfChild = Context.CreateRecorder(TEXT("ParentOfChild"));
+		USimpleEventRecorder* MatchAll = Context.CreateRecorder(TEXT("MatchAll"));
+		USimpleEventRecorder* Other = Context.CreateRecorder(TEXT("Other"));
+
+		Context.Listen(ExactParent, FGameplayTagContainer(TestEventParentTag));
+		Context.Listen(ExactChild, FGameplayTagContainer(TestEventChildTag));
+		// A non exact filter of "A.B" also matches events sent with its parent tag "A"
+		Context.Listen(ParentOfChild, FGameplayTagContainer(TestEventChildTag), false);
+		Context.Listen(MatchAll, FGameplayTagContainer());
+		Context.Listen(Other, FGameplayTagContainer(TestEventOtherTag));
+
+		// --- Listeners are called from the most recently added to the oldest ---
+		Context.EventSubsystem->SendEvent(TestEventParentTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+
+		const TArray<FName> ExpectedParentOrder = { TEXT("MatchAll"), TEXT("ParentOfChild"), TEXT("ExactParent") };
+		Res &= Test->TestEqual(TEXT("Dispatch: Parent event should reach 3 listeners"), Context.ReceivedLog.Num(), ExpectedParentOrder.Num());
+		Res &= Test->TestTrue(TEXT("Dispatch: Parent event listeners called newest first"), Context.ReceivedLog == ExpectedParentOrder);
+
+		// --- Exact and non exact subscriptions on the child tag ---
+		Context.ReceivedLog.Reset();
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+
+		const TArray<FName> ExpectedChildOrder = { TEXT("MatchAll"), TEXT("ParentOfChild"), TEXT("ExactChild") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Child event listeners called newest first"), Context.ReceivedLog == ExpectedChildOrder);
+
+		// --- Sender filter ---
+		Context.ReceivedLog.Reset();
+		USimpleEventRecorder* SenderFiltered = Context.CreateRecorder(TEXT("SenderFiltered"));
+		Context.Listen(SenderFiltered, FGameplayTagContainer(TestEventOtherTag), true, { ExactParent });
+
+		Context.EventSubsystem->SendEvent(TestEventOtherTag, FGameplayTag(), FInstancedStruct(), ExactChild, {});
+		const TArray<FName> ExpectedWrongSenderOrder = { TEXT("MatchAll"), TEXT("Other") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Sender filtered listener ignores other senders"), Context.ReceivedLog == ExpectedWrongSenderOrder);
+
+		Context.ReceivedLog.Reset();
+		Context.EventSubsystem->SendEvent(TestEventOtherTag, FGameplayTag(), FInstancedStruct(), ExactParent, {});
+		const TArray<FName> ExpectedSenderOrder = { TEXT("SenderFiltered"), TEXT("MatchAll"), TEXT("Other") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Sender filtered listener receives its sender"), Context.ReceivedLog == ExpectedSenderOrder);
+
+		// --- Unsubscribing ---
+		Context.ReceivedLog.Reset();
+		USimpleEventRecorder* Once = Context.CreateRecorder(TEXT("Once"));
+		Context.Listen(Once, FGameplayTagContainer(TestEventParentTag), true, {}, true);
+		Context.EventSubsystem->StopListeningForAllEvents(MatchAll);
+		Context.EventSubsystem->StopListeningForAllEvents(ParentOfChild);
+
+		Context.EventSubsystem->SendEvent(TestEventParentTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+		Context.EventSubsystem->SendEvent(TestEventParentTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+		const TArray<FName> ExpectedUnsubscribedOrder = { TEXT("Once"), TEXT("ExactParent"), TEXT("ExactParent") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Removed and trigger once listeners are not called again"), Context.ReceivedLog == ExpectedUnsubscribedOrder);
+
+		// --- Subscription handles ---
+		Context.ReceivedLog.Reset();
+		const FGuid OtherSubscriptionID = Context.Listen(Other, FGameplayTagContainer(TestEventParentTag));
+		const FEventSubscriptionHandle OtherHandle = Context.EventSubsystem->GetEventSubscriptionHandle(OtherSubscriptionID);
+		Res &= Test->TestTrue(TEXT("Dispatch: Subscription ID resolves to a handle"), OtherHandle.IsValid());
+
+		Context.EventSubsystem->StopListeningForEventSubscription(OtherHandle);
+		Res &= Test->TestFalse(TEXT("Dispatch: Removed subscription ID no longer resolves"),
+			Context.EventSubsystem->GetEventSubscriptionHandle(OtherSubscriptionID).IsValid());
+
+		// Compacting frees the slot so the next subscription reuses it with a new generation
+		Context.EventSubsystem->Tick(0.0f);
+		const FGuid ReusedSubscriptionID = Context.Listen(Other, FGameplayTagContainer(TestEventChildTag));
+		const FEventSubscriptionHandle ReusedHandle = Context.EventSubsystem->GetEventSubscriptionHandle(ReusedSubscriptionID);
+		Res &= Test->TestFalse(TEXT("Dispatch: Stale handle doesn't match a reused slot"), ReusedHandle == OtherHandle);
+
+		Context.EventSubsystem->StopListeningForEventSubscription(OtherHandle);
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+		const TArray<FName> ExpectedReusedOrder = { TEXT("Other"), TEXT("ExactChild") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Stopping a stale handle doesn't remove the new subscription"), Context.ReceivedLog == ExpectedReusedOrder);
+
+		// --- Native listeners ---
+		Context.ReceivedLog.Reset();
+		USimpleEventRecorder* Native = Context.CreateRecorder(TEXT("Native"));
+		TArray<FName>* ReceivedLog = &Context.ReceivedLog;
+		Context.EventSubsystem->ListenForEvent(Native, false, FGameplayTagContainer(TestEventChildTag), FGameplayTagContainer(),
+			FSimpleNativeEventDelegate::CreateLambda([ReceivedLog](FGameplayTag, FGameplayTag, const FInstancedStruct&, UObject*)
+			{
+				ReceivedLog->Add(TEXT("Native"));
+			}));
+
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+		const TArray<FName> ExpectedNativeOrder = { TEXT("Native"), TEXT("Other"), TEXT("ExactChild") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Native listeners are ordered with dynamic listeners"), Context.ReceivedLog == ExpectedNativeOrder);
+
+		// --- Typed listeners ---
+		Context.ReceivedLog.Reset();
+		USimpleEventRecorder* Typed = Context.CreateRecorder(TEXT("Typed"));
+		FVector TypedPayload = FVector::ZeroVector;
+		Context.EventSubsystem->ListenForEvent<FVector>(Typed, false, FGameplayTagContainer(TestEventChildTag), FGameplayTagContainer(),
+			TSimpleEventDelegate<FVector>::CreateLambda([ReceivedLog, &TypedPayload](FGameplayTag, FGameplayTag, const FVector& Payload, UObject*)
+			{
+				ReceivedLog->Add(TEXT("Typed"));
+				TypedPayload = Payload;
+			}));
+
+		Context.EventSubsystem->SendEvent<FVector>(TestEventChildTag, FGameplayTag(), FVector(7.0));
+		const TArray<FName> ExpectedTypedOrder = { TEXT("Typed"), TEXT("Native"), TEXT("Other"), TEXT("ExactChild") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Typed events reach typed and untyped listeners"), Context.ReceivedLog == ExpectedTypedOrder);
+		Res &= Test->TestEqual(TEXT("Dispatch: Typed listener receives the typed payload"), TypedPayload, FVector(7.0));
+		Context.EventSubsystem->StopListeningForAllEvents(Typed);
+
+		// --- Priorities and consuming listeners ---
+		Context.ReceivedLog.Reset();
+		USimpleEventRecorder* HighPriority = Context.CreateRecorder(TEXT("HighPriority"));
+		USimpleEventRecorder* Consumer = Context.CreateRecorder(TEXT("Consumer"));
+		bool ShouldConsume = true;
+		Context.EventSubsystem->ListenForEvent(HighPriority, false, FGameplayTagContainer(TestEventChildTag), FGameplayTagContainer(),
+			FSimpleNativeEventDelegate::CreateLambda([ReceivedLog](FGameplayTag, FGameplayTag, const FInstancedStruct&, UObject*)
+			{
+				ReceivedLog->Add(TEXT("HighPriority"));
+			}), {}, {}, true, true, 20);
+		// Added after HighPriority but called after it because of its lower priority
+		Context.EventSubsystem->ListenForEvent(Consumer, false, FGameplayTagContainer(TestEventChildTag), FGameplayTagContainer(),
+			FSimpleConsumingEventDelegate::CreateLambda([ReceivedLog, &ShouldConsume](FGameplayTag, FGameplayTag, const FInstancedStruct&, UObject*)
+			{
+				ReceivedLog->Add(TEXT("Consumer"));
+				return ShouldConsume;
+			}), {}, {}, true, true, 10);
+
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+		const TArray<FName> ExpectedConsumedOrder = { TEXT("HighPriority"), TEXT("Consumer") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Consumed events skip lower priority listeners"), Context.ReceivedLog == ExpectedConsumedOrder);
+
+		Context.ReceivedLog.Reset();
+		ShouldConsume = false;
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+		const TArray<FName> ExpectedPriorityOrder = { TEXT("HighPriority"), TEXT("Consumer"), TEXT("Native"), TEXT("Other"), TEXT("ExactChild") };
+		Res &= Test->TestTrue(TEXT("Dispatch: Higher priority listeners are called first"), Context.ReceivedLog == ExpectedPriorityOrder);
+
+		for (USimpleEventRecorder* Recorder : { ExactParent, ExactChild, Other, SenderFiltered, Native, HighPriority, Consumer })
+		{
+			Context.EventSubsystem->StopListeningForAllEvents(Recorder);
+		}
+
+		return Res;
+	}
+
+	bool TestCoalescing() const
+	{
+		FEventSubsystemTestContext Context(TEXT(".CoalescingScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("Coalescing: EventSubsystem should exist"), Context.EventSubsystem);
+		if (!Context.EventSubsystem) return Res;
+
+		USimpleEventRecorder* Listener = Context.CreateRecorder(TEXT("Listener"));
+		USimpleEventRecorder* SenderA = Context.CreateRecorder(TEXT("SenderA"));
+		USimpleEventRecorder* SenderB = Context.CreateRecorder(TEXT("SenderB"));
+
+		TArray<TPair<UObject*, FVector>> Received;
+		Context.EventSubsystem->ListenForEvent(Listener, false, FGameplayTagContainer(TestEventChildTag), FGameplayTagContainer(),
+			FSimpleNativeEventDelegate::CreateLambda([&Received](FGameplayTag, FGameplayTag, const FInstancedStruct& Payload, UObject* Sender)
+			{
+				Received.Emplace(Sender, Payload.Get<FVector>());
+			}));
+
+		// Coalescing the parent tag also coalesces its child tags
+		Context.EventSubsystem->SetEventFlushPoint(ESimpleEventFlushPoint::Manual);
+		Context.EventSubsystem->AddCoalescableEventTags(FGameplayTagContainer(TestEventParentTag));
+
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct::Make(FVector(1.0)), SenderA, {});
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct::Make(FVector(2.0)), SenderB, {});
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct::Make(FVector(3.0)), SenderA, {});
+
+		Res &= Test->TestEqual(TEXT("Coalescing: Coalescable events are queued instead of delivered"), Received.Num(), 0);
+		Res &= Test->TestEqual(TEXT("Coalescing: Events from the same sender share a queue entry"), Context.EventSubsystem->GetNumQueuedEvents(), 2);
+
+		Context.EventSubsystem->FlushQueuedEvents();
+		Res &= Test->TestEqual(TEXT("Coalescing: One event per sender is delivered on flush"), Received.Num(), 2);
+		if (Received.Num() == 2)
+		{
+			Res &= Test->TestTrue(TEXT("Coalescing: Events are delivered in the order they were first queued"),
+				Received[0].Key == SenderA && Received[1].Key == SenderB);
+			Res &= Test->TestEqual(TEXT("Coalescing: The latest payload is delivered"), Received[0].Value, FVector(3.0));
+		}
+
+		// Listener filtered events skip the queue
+		Received.Reset();
+		TArray<UObject*> ListenerFilter = { Listener };
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct::Make(FVector(4.0)), SenderA, ListenerFilter);
+		Res &= Test->TestEqual(TEXT("Coalescing: Listener filtered events are delivered immediately"), Received.Num(), 1);
+
+		Received.Reset();
+		Context.EventSubsystem->RemoveCoalescableEventTags(FGameplayTagContainer(TestEventParentTag));
+		Context.EventSubsystem->SendEvent(TestEventChildTag, FGameplayTag(), FInstancedStruct::Make(FVector(5.0)), SenderA, {});
+		Res &= Test->TestEqual(TEXT("Coalescing: Events are delivered immediately once no longer coalescable"), Received.Num(), 1);
+
+		Context.EventSubsystem->SetEventFlushPoint(ESimpleEventFlushPoint::EndOfFrame);
+		Context.EventSubsystem->StopListeningForAllEvents(Listener);
+
+		return Res;
+	}
+
+	bool TestWorldScoping() const
+	{
+		FEventSubsystemTestContext Context(TEXT(".WorldScopingScenario"));
+		FTestFixture OtherWorldFixture(TEXT(EventTestNamePrefix ".WorldScopingScenario.OtherWorld"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("WorldScoping: EventSubsystem should exist"), Context.EventSubsystem);
+		if (!Context.EventSubsystem) return Res;
+
+		UWorld* World = Context.TestFixture.GetWorld();
+		UWorld* OtherWorld = OtherWorldFixture.GetWorld();
+
+		// Recorders outered to a world are in that world, the others aren't in any world
+		USimpleEventRecorder* WorldListener = Context.CreateRecorder(TEXT("WorldListener"), World);
+		USimpleEventRecorder* GlobalListener = Context.CreateRecorder(TEXT("GlobalListener"));
+		USimpleEventRecorder* OtherWorldSender = Context.CreateRecorder(TEXT("OtherWorldSender"), OtherWorld);
+		Context.Listen(WorldListener, FGameplayTagContainer(TestEventParentTag));
+		Context.Listen(GlobalListener, FGameplayTagContainer(TestEventParentTag));
+
+		Context.EventSubsystem->DispatchEvent(TestEventParentTag, FGameplayTag(), FInstancedStruct(), nullptr, {}, World);
+		const TArray<FName> ExpectedSameWorldOrder = { TEXT("GlobalListener"), TEXT("WorldListener") };
+		Res &= Test->TestTrue(TEXT("WorldScoping: Events in a world reach its listeners and global listeners"), Context.ReceivedLog == ExpectedSameWorldOrder);
+
+		Context.ReceivedLog.Reset();
+		Context.EventSubsystem->DispatchEvent(TestEventParentTag, FGameplayTag(), FInstancedStruct(), nullptr, {}, OtherWorld);
+		const TArray<FName> ExpectedOtherWorldOrder = { TEXT("GlobalListener") };
+		Res &= Test->TestTrue(TEXT("WorldScoping: Events in another world don't reach this world's listeners"), Context.ReceivedLog == ExpectedOtherWorldOrder);
+
+		Context.ReceivedLog.Reset();
+		Context.EventSubsystem->SendEvent(TestEventParentTag, FGameplayTag(), FInstancedStruct(), OtherWorldSender, {});
+		Res &= Test->TestTrue(TEXT("WorldScoping: Events use the world of their sender"), Context.ReceivedLog == ExpectedOtherWorldOrder);
+
+		Context.ReceivedLog.Reset();
+		Context.EventSubsystem->SendEvent(TestEventParentTag, FGameplayTag(), FInstancedStruct(), nullptr, {});
+		Res &= Test->TestTrue(TEXT("WorldScoping: Events without a world reach every world"), Context.ReceivedLog == ExpectedSameWorldOrder);
+
+		Context.EventSubsystem->StopListeningForAllEvents(WorldListener);
+		Context.EventSubsystem->StopListeningForAllEvents(GlobalListener);
+
+		return Res;
+	}
+
+	bool TestInvalidListenerSweep() const
+	{
+		FEventSubsystemTestContext Context(TEXT(".InvalidListenerSweepScenario"));
+		FDebugTestResult Res;
+
+		Res &= Test->TestNotNull(TEXT("InvalidListenerSweep: EventSubsystem should exist"), Context.EventSubsystem);
+		if (!Context.EventSubsystem) return Res;
+
+		USimpleEventRecorder* Listener = Context.CreateRecorder(TEXT("Listener"));
+		USimpleEventRecorder* Sender = Context.CreateRecorder(TEXT("Sender"));
+		const FGuid SubscriptionID = Context.Listen(Listener, FGameplayTagContainer(TestEventParentTag), true, { Sender });
+
+		Res &= Test->TestTrue(TEXT("InvalidListenerSweep: Subscription was added"), Context.EventSubsystem->GetEventSubscriptionHandle(SubscriptionID).IsValid());
+
+		// With its sender gone too, no event is ever dispatched to the subscription to find its listener is gone
+		Listener->MarkAsGarbage();
+		Sender->MarkAsGarbage();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		Res &= Test->TestTrue(TEXT("InvalidListenerSweep: Subsystem ticks after a garbage collection"), Context.EventSubsystem->IsTickable());
+		Context.EventSubsystem->Tick(0.0f);
+
+		Res &= Test->TestFalse(TEXT("InvalidListenerSweep: Tick removed the subscription of the garbage collected listener"),
+			Context.EventSubsystem->GetEventSubscriptionHandle(SubscriptionID).IsValid());
+		Res &= Test->TestFalse(TEXT("InvalidListenerSweep: Nothing is left to compact"), Context.EventSubsystem->IsTickable());
+
+		return Res;
+	}
+};
+
+
+bool FEventSubsystemTest_Dispatch::RunTest(const FString& Parameters)
+{
+	FEventSubsystemTestScenarios TestScenarios(this);
+	return TestScenarios.TestDispatch();
+}
+
+bool FEventSubsystemTest_Coalescing::RunTest(const FString& Parameters)
+{
+	FEventSubsystemTestScenarios TestScenarios(this);
+	return TestScenarios.TestCoalescing();
+}
+
+bool FEventSubsystemTest_WorldScoping::RunTest(const FString& Parameters)
+{
+	FEventSubsystemTestScenarios TestScenarios(this);
+	return TestScenarios.TestWorldScoping();
+}
+
+bool FEventSubsystemTest_InvalidListenerSweep::RunTest(const FString& Parameters)
+{
+	FEventSubsystemTestScenarios TestScenarios(this);
+	return TestScenarios.TestInvalidListenerSweep();
+}
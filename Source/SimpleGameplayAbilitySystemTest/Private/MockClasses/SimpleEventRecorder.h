@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameplayTagContainer.h"
+#include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventTypes.h" // For FInstancedStruct
+#include "SimpleEventRecorder.generated.h"
+
+UCLASS()
+class USimpleEventRecorder : public UObject
+{
+    GENERATED_BODY()
+public:
+    // Name this recorder writes to the log when it receives an event
+    FName Label;
+    // Shared between recorders so tests can check the order listeners were called in
+    TArray<FName>* ReceivedLog = nullptr;
+
+    UFUNCTION()
+    void HandleEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload, UObject* Sender)
+    {
+        if (ReceivedLog)
+        {
+            ReceivedLog->Add(Label);
+        }
+    }
+};
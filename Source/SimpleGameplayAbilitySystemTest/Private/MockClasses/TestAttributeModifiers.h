@@ -0,0 +1,211 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAttributeModifier/SimpleAttributeModifier.h"
+#include "TestAttributeModifiers.generated.h"
+
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TestAttributeTag);
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TestMissingAttributeTag);
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TestRequiredTag);
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TestBlockingTag);
+
+UCLASS()
+class UTestPredictedInstantModifier : public USimpleAttributeModifier
+{
+    GENERATED_BODY()
+public:
+    UTestPredictedInstantModifier()
+    {
+        ModifierType = EAttributeModifierType::Instant;
+        ModifierApplicationPolicy = EAttributeModifierApplicationPolicy::ApplyClientPredicted;
+    }
+};
+
+// Adds 10 to the current value of TestAttributeTag, doubles it and subtracts 5 from the base value
+UCLASS()
+class UTestMultiStepModifier : public USimpleAttributeModifier
+{
+    GENERATED_BODY()
+public:
+    UTestMultiStepModifier()
+    {
+        ModifierType = EAttributeModifierType::Instant;
+        ModifierApplicationPolicy = EAttributeModifierApplicationPolicy::ApplyServerOnly;
+
+        AddModification(EAttributeValueType::CurrentValue, EFloatAttributeModificationOperation::Add, 10.0f);
+        AddModification(EAttributeValueType::CurrentValue, EFloatAttributeModificationOperation::Multiply, 2.0f);
+        AddModification(EAttributeValueType::BaseValue, EFloatAttributeModificationOperation::Subtract, 5.0f);
+    }
+
+private:
+    void AddModification(EAttributeValueType ValueType, EFloatAttributeModificationOperation Operation, float InputValue)
+    {
+        FFloatAttributeModifier& Modification = FloatAttributeModifications.AddDefaulted_GetRef();
+        Modification.AttributeToModify = TestAttributeTag;
+        Modification.ModifiedAttributeValueType = ValueType;
+        Modification.ModificationInputValueSource = EAttributeModificationValueSource::Manual;
+        Modification.ManualInputValue = InputValue;
+        Modification.ModificationOperation = Operation;
+    }
+};
+
+// Adds 10 to the current value of TestAttributeTag, then fails because TestMissingAttributeTag is never added
+UCLASS()
+class UTestPartiallyFailingModifier : public USimpleAttributeModifier
+{
+    GENERATED_BODY()
+public:
+    UTestPartiallyFailingModifier()
+    {
+        ModifierType = EAttributeModifierType::Instant;
+        ModifierApplicationPolicy = EAttributeModifierApplicationPolicy::ApplyServerOnly;
+
+        AddModification(TestAttributeTag);
+        AddModification(TestMissingAttributeTag);
+    }
+
+private:
+    void AddModification(const FGameplayTag& AttributeTag)
+    {
+        FFloatAttributeModifier& Modification = FloatAttributeModifications.AddDefaulted_GetRef();
+        Modification.AttributeToModify = AttributeTag;
+        Modification.ModifiedAttributeValueType = EAttributeValueType::CurrentValue;
+        Modification.ModificationInputValueSource = EAttributeModificationValueSource::Manual;
+        Modification.ManualInputValue = 10.0f;
+        Modification.ModificationOperation = EFloatAttributeModificationOperation::Add;
+        Modification.IfAttributeNotFound = EAttributeModiferNotFoundBehaviour::CancelModifier;
+    }
+};
+
+// Same as UTestPartiallyFailingModifier but applied through its instant modifier spec
+UCLASS()
+class UTestPartiallyFailingSpecModifier : public UTestPartiallyFailingModifier
+{
+    GENERATED_BODY()
+public:
+    UTestPartiallyFailingSpecModifier()
+    {
+        UseInstantModifierSpec = true;
+        InstantModifierSpecNativeClass = StaticClass();
+    }
+};
+
+// Inherits UseInstantModifierSpec but blocks every application from a native CanApplyModifier override
+UCLASS()
+class UTestNativeCanApplySpecModifier : public UTestPartiallyFailingSpecModifier
+{
+    GENERATED_BODY()
+public:
+    virtual bool CanApplyModifier_Implementation(FInstancedStruct ModifierContext) const override
+    {
+        return false;
+    }
+};
+
+// Adds 1 to the current value of TestAttributeTag if the target has TestRequiredTag and doesn't have TestBlockingTag
+UCLASS()
+class UTestTagRequirementModifier : public USimpleAttributeModifier
+{
+    GENERATED_BODY()
+public:
+    UTestTagRequirementModifier()
+    {
+        ModifierType = EAttributeModifierType::Instant;
+        ModifierApplicationPolicy = EAttributeModifierApplicationPolicy::ApplyServerOnly;
+        TargetRequiredTags.AddTag(TestRequiredTag);
+        TargetBlockingTags.AddTag(TestBlockingTag);
+
+        FFloatAttributeModifier& Modification = FloatAttributeModifications.AddDefaulted_GetRef();
+        Modification.AttributeToModify = TestAttributeTag;
+        Modification.ModifiedAttributeValueType = EAttributeValueType::CurrentValue;
+        Modification.ModificationInputValueSource = EAttributeModificationValueSource::Manual;
+        Modification.ManualInputValue = 1.0f;
+        Modification.ModificationOperation = EFloatAttributeModificationOperation::Add;
+    }
+};
+
+// Adds twice the input value of 5 to the current value of TestAttributeTag through a custom operation function selector
+UCLASS()
+class UTestFunctionSelectorModifier : public USimpleAttributeModifier
+{
+    GENERATED_BODY()
+public:
+    UTestFunctionSelectorModifier()
+    {
+        ModifierType = EAttributeModifierType::Instant;
+        ModifierApplicationPolicy = EAttributeModifierApplicationPolicy::ApplyServerOnly;
+
+        FFloatAttributeModifier& Modification = FloatAttributeModifications.AddDefaulted_GetRef();
+        Modification.AttributeToModify = TestAttributeTag;
+        Modification.ModifiedAttributeValueType = EAttributeValueType::CurrentValue;
+        Modification.ModificationInputValueSource = EAttributeModificationValueSource::Manual;
+        Modification.ManualInputValue = 5.0f;
+        Modification.ModificationOperation = EFloatAttributeModificationOperation::Custom;
+        Modification.IfAttributeNotFound = EAttributeModiferNotFoundBehaviour::CancelModifier;
+        Modification.FloatOperationFunction.SetSelfMember(GET_FUNCTION_NAME_CHECKED(UTestFunctionSelectorModifier, AddTwiceOperation));
+    }
+
+    UFUNCTION()
+    bool AddTwiceOperation(FGameplayTag AttributeTag, float CurrentAttributeValue, float OperationInputValue, float CurrentOverflow,
+        FGameplayTag& EventTagOverride, float& NewAttributeValue, float& NewOverflow)
+    {
+        NewAttributeValue = CurrentAttributeValue + OperationInputValue * 2.0f;
+        NewOverflow = CurrentOverflow;
+        return true;
+    }
+
+    UFUNCTION()
+    bool WrongSignatureOperation(FGameplayTag AttributeTag, FInstancedStruct OperationInput)
+    {
+        return true;
+    }
+};
+
+// Same as UTestFunctionSelectorModifier but selects a function that doesn't match the operation prototype
+UCLASS()
+class UTestWrongSelectorSignatureModifier : public UTestFunctionSelectorModifier
+{
+    GENERATED_BODY()
+public:
+    UTestWrongSelectorSignatureModifier()
+    {
+        FloatAttributeModifications[0].FloatOperationFunction.SetSelfMember(GET_FUNCTION_NAME_CHECKED(UTestFunctionSelectorModifier, WrongSignatureOperation));
+    }
+};
+
+// Keeps at most 3 snapshots in the history of its attribute state
+UCLASS()
+class UTestSnapshotHistoryModifier : public USimpleAttributeModifier
+{
+    GENERATED_BODY()
+public:
+    UTestSnapshotHistoryModifier()
+    {
+        MaxSnapshotHistory = 3;
+    }
+};
+
+// Adds 1 to TestAttributeTag every 0.5 seconds for 2 seconds
+UCLASS()
+class UTestDurationModifier : public USimpleAttributeModifier
+{
+    GENERATED_BODY()
+public:
+    UTestDurationModifier()
+    {
+        ModifierType = EAttributeModifierType::Duration;
+        ModifierApplicationPolicy = EAttributeModifierApplicationPolicy::ApplyServerOnly;
+        Duration = 2.0f;
+        TickInterval = 0.5f;
+        TickOnApply = false;
+
+        FFloatAttributeModifier& TickModification = FloatAttributeModifications.AddDefaulted_GetRef();
+        TickModification.ApplicationRequirements.Add(EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
+        TickModification.AttributeToModify = TestAttributeTag;
+        TickModification.ModifiedAttributeValueType = EAttributeValueType::CurrentValue;
+        TickModification.ModificationInputValueSource = EAttributeModificationValueSource::Manual;
+        TickModification.ManualInputValue = 1.0f;
+        TickModification.ModificationOperation = EFloatAttributeModificationOperation::Add;
+    }
+};
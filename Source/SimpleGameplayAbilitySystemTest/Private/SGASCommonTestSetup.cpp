@@ -9,6 +9,9 @@
 
 // Define Gameplay Tags
 UE_DEFINE_GAMEPLAY_TAG(TestAttributeTag, "Test.SGAS.Attributes.MyTestAttribute");
+UE_DEFINE_GAMEPLAY_TAG(TestMissingAttributeTag, "Test.SGAS.Attributes.MyMissingAttribute");
+UE_DEFINE_GAMEPLAY_TAG(TestRequiredTag, "Test.SGAS.Tags.Required");
+UE_DEFINE_GAMEPLAY_TAG(TestBlockingTag, "Test.SGAS.Tags.Blocking");
 
 // Test fixture that sets up the persistent test world and subsystem
 class FTestFixture